@@ -190,6 +190,12 @@ int main() {
             auto multiQueue = renderGraph.multiQueue();
             if (ImGui::Checkbox("MultiQueue", &multiQueue))
                 renderGraph.setMultiQueue(multiQueue);
+            auto splitBarriers = renderGraph.splitBarriers();
+            if (ImGui::Checkbox("Split Barriers", &splitBarriers))
+                renderGraph.setSplitBarriers(splitBarriers);
+            auto reorderPasses = renderGraph.reorderPasses();
+            if (ImGui::Checkbox("Reorder Passes", &reorderPasses))
+                renderGraph.setReorderPasses(reorderPasses);
             const char* modes[] = { "DISABLED", "PER_PASS", "PER_GROUP" };
             static int timingModeIndex = static_cast<int>(renderGraph.timingMode());
             if (ImGui::Combo("Timing Mode", &timingModeIndex, modes, 3)) {
@@ -256,6 +262,9 @@ int main() {
             ImGui::Text("Image: %d", renderGraphStats.images);
             ImGui::Text("Buffers: %d", renderGraphStats.buffers);
             ImGui::Text("Command Buffers: %d", renderGraphStats.commandBuffers);
+            ImGui::Text("Transient Memory: %lu / %lu", renderGraphStats.transientMemory, renderGraphStats.naiveTransientMemory);
+            ImGui::Text("Barriers: %d, Split: %d", renderGraphStats.barriers, renderGraphStats.splitBarriers);
+            ImGui::Text("Reorder Barriers: %d -> %d", renderGraphStats.barriersBeforeReorder, renderGraphStats.barriersAfterReorder);
 
             if (ImGui::TreeNode("markers")) {
                 auto& markers = device->getFrameDebugMarkers(device->framePrevValue() % canta::FRAMES_IN_FLIGHT);
@@ -22,6 +22,9 @@ class Buffer {
         u32 preferredFlags = 0;
         bool persistentlyMapped = false;
         std::string_view name = {};
+        // bind to existing memory instead of allocating. memory is owned by the caller
+        VmaAllocation aliasAllocation = VK_NULL_HANDLE;
+        u64 aliasOffset = 0;
     };
 
     Buffer() = default;
@@ -37,6 +40,7 @@ class Buffer {
     [[nodiscard]] auto usage() const -> BufferUsage { return _usage; }
     [[nodiscard]] auto size() const -> u32 { return _size; }
     [[nodiscard]] auto persistentlyMapped() const -> bool { return _mapped._address; }
+    [[nodiscard]] auto aliased() const -> bool { return _aliased; }
     [[nodiscard]] auto name() const -> std::string_view { return _name; }
 
     class Mapped {
@@ -94,6 +98,7 @@ class Buffer {
     Mapped _mapped = {};
     u32 _requiredFlags = 0;
     u32 _preferredFlags = 0;
+    bool _aliased = false;
     std::string _name = {};
 };
 
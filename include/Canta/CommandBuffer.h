@@ -81,7 +81,8 @@ class CommandBuffer {
 
     [[nodiscard]] auto buffer() const -> VkCommandBuffer { return _buffer; }
 
-    auto begin() -> bool;
+    // buffers recorded once and submitted again on later frames must not be one time submit
+    auto begin(bool oneTimeSubmit = true) -> bool;
     auto end() -> bool;
 
     auto isActive() const -> bool { return _active; }
@@ -167,6 +168,13 @@ class CommandBuffer {
     void barrier(ImageBarrier barrier);
     void barrier(BufferBarrier barrier);
     void barrier(MemoryBarrier barrier);
+    // all barriers in a single dependency
+    void barriers(std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers = {}, std::span<const MemoryBarrier> memoryBarriers = {});
+
+    // split barriers, the dependency passed to setEvent and waitEvent must match
+    void setEvent(VkEvent event, std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers = {}, std::span<const MemoryBarrier> memoryBarriers = {});
+    void waitEvent(VkEvent event, std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers = {}, std::span<const MemoryBarrier> memoryBarriers = {});
+    void resetEvent(VkEvent event, PipelineStage stage);
 
     void pushDebugLabel(std::string_view label, std::array<f32, 4> colour = {0, 1, 0, 1});
     void popDebugLabel();
@@ -34,6 +34,8 @@ class CommandPool {
 
     auto bufferCount() const -> u32 { return _commandBuffers.used(); }
 
+    auto queueType() const -> QueueType { return _queueType; }
+
     auto queue() -> std::shared_ptr<Queue>;
 
   private:
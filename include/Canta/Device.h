@@ -3,6 +3,7 @@
 
 #include <Canta/Buffer.h>
 #include <Canta/CommandPool.h>
+#include <Canta/EventPool.h>
 #include <Canta/Enums.h>
 #include <Canta/Image.h>
 #include <Canta/Pipeline.h>
@@ -49,6 +50,9 @@ using BufferHandle = Handle<Buffer, ResourceList<Buffer>>;
 using SamplerHandle = Handle<Sampler, ResourceList<Sampler>>;
 using SemaphoreHandle = Handle<Semaphore, ResourceList<Semaphore>>;
 
+using ImageRef = Ref<Image, ResourceList<Image>>;
+using BufferRef = Ref<Buffer, ResourceList<Buffer>>;
+
 struct Limits {
     u32 maxImageDimensions1D = 0;
     u32 maxImageDimensions2D = 0;
@@ -227,8 +231,11 @@ class Device {
     [[nodiscard]] auto createSwapchain(Swapchain::CreateInfo info) -> std::expected<Swapchain, VulkanError>;
 
     [[nodiscard]] auto createSemaphore(Semaphore::CreateInfo info) -> std::expected<SemaphoreHandle, VulkanError>;
+    // true once all, or any when waitAll is false, of the timelines reach their values. false on timeout
+    [[nodiscard]] auto waitSemaphores(std::span<const SemaphorePair> semaphores, bool waitAll = true, u64 timeout = 1000000000) const -> std::expected<bool, VulkanError>;
 
     [[nodiscard]] auto createCommandPool(CommandPool::CreateInfo info) -> std::expected<CommandPool, VulkanError>;
+    [[nodiscard]] auto createEventPool(EventPool::CreateInfo info) -> std::expected<EventPool, VulkanError>;
 
     [[nodiscard]] auto createPipeline(Pipeline::CreateInfo info, const PipelineHandle &oldHandle = {}) -> PipelineHandle;
     [[nodiscard]] auto createImage(Image::CreateInfo info, ImageHandle oldHandle = {}) -> ImageHandle;
@@ -241,6 +248,14 @@ class Device {
 
     [[nodiscard]] auto swapImageBindings(ImageHandle oldHandle, ImageHandle newHandle) -> ImageHandle;
 
+    // query memory requirements without creating the resource
+    [[nodiscard]] auto memoryRequirements(Buffer::CreateInfo info) const -> VkMemoryRequirements;
+    [[nodiscard]] auto memoryRequirements(Image::CreateInfo info) const -> VkMemoryRequirements;
+
+    // raw device local memory for aliasing resources into. see Buffer::CreateInfo::aliasAllocation
+    [[nodiscard]] auto allocateMemory(const VkMemoryRequirements &requirements) -> std::expected<VmaAllocation, VulkanError>;
+    void freeMemory(VmaAllocation allocation);
+
     template <typename T = u8>
     [[nodiscard]] auto alloc(const std::size_t count, const BufferUsage usage = BufferUsage::STORAGE | BufferUsage::TRANSFER_DST | BufferUsage::TRANSFER_SRC) -> Ptr<T> {
         const auto buffer = createBuffer({
@@ -257,6 +272,12 @@ class Device {
     [[nodiscard]] auto timestampPools() -> std::span<VkQueryPool> { return _timestampPools; }
 
     [[nodiscard]] auto createTimer() -> Timer;
+    // device and host timestamps in nanoseconds taken at the same moment, the host clock matches std::chrono::steady_clock
+    struct TimestampCalibration {
+        u64 device = 0;
+        u64 host = 0;
+    };
+    [[nodiscard]] auto calibrateTimestamps() const -> std::expected<TimestampCalibration, VulkanError>;
     void destroyTimer(u32 poolIndex, u32 queryIndex);
 
     [[nodiscard]] auto pipelineStatisticsPools() -> std::span<VkQueryPool> { return _pipelineStatisticsPools; }
@@ -277,6 +298,9 @@ class Device {
         u32 samplerAllocated = 0;
         u32 timestampQueryPools = 0;
         u32 pipelineStatsPools = 0;
+        // released and destroyed across all resource types by the last gc()
+        u32 queuedForDestruction = 0;
+        u32 destroyed = 0;
     };
     [[nodiscard]] auto resourceStats() const -> ResourceStats;
 
@@ -307,6 +331,11 @@ class Device {
     void triggerCapture() const;
 
     void updateBindlessDescriptors();
+    // bindless writes still missing from the set of at least one frame in flight
+    [[nodiscard]] auto pendingDescriptorUpdates() -> u32 {
+        std::unique_lock lock(_descriptorMutex);
+        return _descriptorUpdates.size();
+    }
 
   private:
     friend CommandBuffer;
@@ -331,6 +360,7 @@ class Device {
 
     bool _meshShadersEnabled = false;
     bool _taskShadersEnabled = false;
+    bool _calibratedTimestamps = false;
 
     std::shared_ptr<Queue> _graphicsQueue = {};
     std::shared_ptr<Queue> _computeQueue = {};
@@ -383,9 +413,13 @@ class Device {
         bool storage = false;
         BufferHandle buffer = {};
         SamplerHandle sampler = {};
-        u64 endFrame = 0;
+        // bit per frame in flight whose bindless set has been written
+        u32 writtenSets = 0;
     };
     std::vector<DescriptorUpdate> _descriptorUpdates = {};
+    std::vector<VkWriteDescriptorSet> _descriptorWrites = {};
+    std::vector<VkDescriptorImageInfo> _descriptorImageInfos = {};
+    std::vector<VkDescriptorBufferInfo> _descriptorBufferInfos = {};
     std::mutex _descriptorMutex = {};
 
     ResourceList<Pipeline> _pipelineList = {};
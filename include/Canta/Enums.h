@@ -100,6 +100,23 @@ enum class QueueType {
     PRESENT = 0x20
 };
 
+constexpr const char *queueTypeString(const QueueType queue) {
+    switch (queue) {
+    case QueueType::GRAPHICS:
+        return "graphics";
+    case QueueType::COMPUTE:
+        return "compute";
+    case QueueType::TRANSFER:
+        return "transfer";
+    case QueueType::SPARSE_BINDING:
+        return "sparse binding";
+    case QueueType::PRESENT:
+        return "present";
+    default:
+        return "none";
+    }
+}
+
 enum class PresentMode {
     IMMEDIATE = VK_PRESENT_MODE_IMMEDIATE_KHR,
     MAILBOX = VK_PRESENT_MODE_MAILBOX_KHR,
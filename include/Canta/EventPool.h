@@ -0,0 +1,44 @@
+#ifndef CANTA_EVENTPOOL_H
+#define CANTA_EVENTPOOL_H
+
+#include <Ende/platform.h>
+#include <string>
+#include <vector>
+#include <volk.h>
+
+namespace canta {
+
+class Device;
+
+class EventPool {
+  public:
+    struct CreateInfo {
+        std::string_view name = {};
+    };
+
+    EventPool() = default;
+
+    ~EventPool();
+
+    EventPool(EventPool &&rhs) noexcept;
+    auto operator=(EventPool &&rhs) noexcept -> EventPool &;
+
+    // events are reused from the start, they must be unsignaled by the time the pool is reset
+    void reset();
+
+    [[nodiscard]] auto getEvent() -> VkEvent;
+
+    auto eventCount() const -> u32 { return _events.size(); }
+
+  private:
+    friend Device;
+
+    Device *_device = nullptr;
+    std::string _name = {};
+    u32 _index = 0;
+    std::vector<VkEvent> _events = {};
+};
+
+} // namespace canta
+
+#endif // CANTA_EVENTPOOL_H
@@ -0,0 +1,52 @@
+#ifndef CANTA_HOSTPASSEXECUTOR_H
+#define CANTA_HOSTPASSEXECUTOR_H
+
+#include <Canta/Device.h>
+#include <Ende/platform.h>
+#include <Ende/thread/ThreadPool.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace canta {
+
+// runs host jobs on a thread pool once the timelines they wait on are reached. a single thread waits on all pending
+// timelines at once so workers are only used by jobs that can run. jobs still pending on destruction are dropped but
+// their signals are still made so queues waiting on them dont hang
+class HostPassExecutor {
+  public:
+    HostPassExecutor(Device *device, std::shared_ptr<ende::thread::ThreadPool> threadPool);
+    ~HostPassExecutor();
+
+    HostPassExecutor(const HostPassExecutor &) = delete;
+    auto operator=(const HostPassExecutor &) -> HostPassExecutor & = delete;
+
+    // signals are the values the job signals once done
+    void enqueue(std::vector<SemaphorePair> waits, std::vector<SemaphorePair> signals, std::function<void()> job);
+
+    auto pending() -> u32;
+
+  private:
+    void run();
+
+    struct PendingJob {
+        std::vector<SemaphorePair> waits = {};
+        std::vector<SemaphorePair> signals = {};
+        std::function<void()> job = {};
+    };
+
+    Device *_device = nullptr;
+    std::shared_ptr<ende::thread::ThreadPool> _threadPool = nullptr;
+
+    std::mutex _mutex = {};
+    std::condition_variable _condition = {};
+    std::vector<PendingJob> _pending = {};
+    bool _running = true;
+    std::thread _thread = {};
+};
+
+} // namespace canta
+
+#endif // CANTA_HOSTPASSEXECUTOR_H
@@ -57,6 +57,9 @@ class Image {
         ImageUsage usage = ImageUsage::SAMPLED | ImageUsage::TRANSFER_DST;
         ImageType type = ImageType::AUTO;
         std::string_view name = {};
+        // bind to existing memory instead of allocating. memory is owned by the caller
+        VmaAllocation aliasAllocation = VK_NULL_HANDLE;
+        u64 aliasOffset = 0;
     };
 
     Image() = default;
@@ -76,6 +79,7 @@ class Image {
     auto usage() const -> ImageUsage { return _usage; }
     auto layout() const -> ImageLayout { return _layout; }
     auto name() const -> std::string_view { return _name; }
+    auto aliased() const -> bool { return _aliased; }
     auto size() const -> u32 { return _width * _height * _depth * _layers * _mips * formatSize(_format); }
 
     auto createView(ImageView::CreateInfo info) const -> ImageViewHandle;
@@ -99,6 +103,7 @@ class Image {
     Format _format = Format::RGBA8_UNORM;
     ImageUsage _usage = ImageUsage::TRANSFER_DST;
     ImageLayout _layout = ImageLayout::UNDEFINED;
+    bool _aliased = false;
     std::string _name = {};
 
     std::vector<ImageViewHandle> _views = {};
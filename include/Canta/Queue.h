@@ -24,6 +24,14 @@ class Queue {
 
     [[nodiscard]] auto submit(std::span<CommandHandle> commandBuffers, std::span<SemaphorePair> waits = {}, std::span<SemaphorePair> signals = {}, VkFence fence = VK_NULL_HANDLE) -> std::expected<bool, VulkanError>;
 
+    struct Submission {
+        std::span<CommandHandle> commandBuffers = {};
+        std::span<SemaphorePair> waits = {};
+        std::span<SemaphorePair> signals = {};
+    };
+    // all submissions in a single vkQueueSubmit2, executed in order
+    [[nodiscard]] auto submitBatch(std::span<const Submission> submissions, VkFence fence = VK_NULL_HANDLE) -> std::expected<bool, VulkanError>;
+
   private:
     friend Device;
 
@@ -3,11 +3,16 @@
 
 #include <Canta/Device.h>
 #include <Canta/Enums.h>
+#include <Canta/HostPassExecutor.h>
 #include <Canta/Semaphore.h>
 #include <Ende/graph/graph.h>
 #include <Ende/platform.h>
 #include <Ende/thread/ThreadPool.h>
+#include <chrono>
 #include <expected>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace canta {
 
@@ -39,12 +44,28 @@ struct BufferIndex : ende::graph::Edge {
     u32 graphIndex = 0;
 };
 
+// range of mips and array layers of an image, a count of 0 covers the remaining mips or layers
+struct ImageSubresource {
+    u32 mip = 0;
+    u32 mipCount = 0;
+    u32 layer = 0;
+    u32 layerCount = 0;
+};
+
+// byte range of a buffer, a size of 0 covers the rest of the buffer
+struct BufferRange {
+    u32 offset = 0;
+    u32 size = 0;
+};
+
 struct ResourceAccess {
     i32 id = -1;
     i32 index = -1;
     Access access = Access::NONE;
     PipelineStage stage = PipelineStage::NONE;
     ImageLayout layout = ImageLayout::UNDEFINED;
+    ImageSubresource subresource = {};
+    BufferRange range = {};
 };
 
 struct BufferInfo {
@@ -69,6 +90,27 @@ struct ImageInfo {
     std::string name = {};
 };
 
+// how a pass treats the contents of an attachment, AUTO derives the op from the surrounding accesses
+enum class AttachmentLoad {
+    AUTO,
+    LOAD,
+    CLEAR,
+    // promise from the caller that every pixel of the render area is written so the previous contents are not needed.
+    // not checked or derived by the graph
+    OVERWRITE,
+};
+
+enum class AttachmentStore {
+    AUTO,
+    STORE,
+    DISCARD,
+};
+
+struct AttachmentHint {
+    AttachmentLoad load = AttachmentLoad::AUTO;
+    AttachmentStore store = AttachmentStore::AUTO;
+};
+
 struct RenderGroup {
     i32 id = -1;
     std::array<f32, 4> colour = {0, 0, 0, 1};
@@ -100,6 +142,35 @@ struct ReadWrite {
     T resource;
 };
 
+// allocator for pass storage, counts the heap allocations made through it so rebuild churn shows up in the graph stats
+template <typename T>
+struct PassAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PassAllocator() = default;
+    explicit PassAllocator(u64 *counter) : counter(counter) {}
+    template <typename U>
+    PassAllocator(const PassAllocator<U> &other) : counter(other.counter) {}
+
+    auto allocate(const std::size_t n) -> T * {
+        if (counter)
+            (*counter)++;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *ptr, const std::size_t n) { std::allocator<T>().deallocate(ptr, n); }
+
+    template <typename U>
+    auto operator==(const PassAllocator<U> &) const -> bool { return true; }
+
+    u64 *counter = nullptr;
+};
+
+template <typename T>
+using PassVector = std::vector<T, PassAllocator<T>>;
+
 class RenderPass : public ende::graph::Vertex<BufferIndex, ImageIndex> {
   public:
     enum class Type {
@@ -173,6 +244,34 @@ class RenderPass : public ende::graph::Vertex<BufferIndex, ImageIndex> {
         _manualPipeline = state;
         return *this;
     }
+    // expected gpu time in nanoseconds, used by cost scheduling in place of measured times
+    auto setCostHint(const u64 nanoseconds) -> RenderPass & {
+        _costHint = nanoseconds;
+        return *this;
+    }
+    auto costHint() const -> u64 { return _costHint; }
+
+    struct Barrier {
+        i32 index = 0;
+        i32 passIndex = 0;
+        // pass of the access being synchronised with, -1 for the resources initial access
+        i32 prevPassIndex = -1;
+        PipelineStage srcStage = PipelineStage::TOP;
+        PipelineStage dstStage = PipelineStage::BOTTOM;
+        Access srcAccess = Access::NONE;
+        Access dstAccess = Access::NONE;
+        ImageLayout srcLayout = ImageLayout::UNDEFINED;
+        ImageLayout dstLayout = ImageLayout::UNDEFINED;
+        QueueType srcQueue = QueueType::NONE;
+        QueueType dstQueue = QueueType::NONE;
+        ImageSubresource subresource = {};
+        BufferRange range = {};
+    };
+    // barriers recorded before the pass, valid once the graph is compiled
+    auto barriers() const -> std::span<const Barrier> { return _barriers; }
+    // attachments with their resolved load and store ops, valid once the graph is compiled
+    auto renderingColourAttachments() const -> std::span<const canta::Attachment> { return _renderingColourAttachments; }
+    auto renderingDepthAttachment() const -> const canta::Attachment & { return _renderingDepthAttachment; }
 
     // auto setCallback(const std::function<void(CommandBuffer&, RenderGraph&, const PushData&)>& callback) -> RenderPass&;
     auto setCallback(const std::function<std::expected<bool, RenderGraphError>(CommandHandle, RenderGraph &, const PushData &)> &callback) -> RenderPass &;
@@ -187,6 +286,8 @@ class RenderPass : public ende::graph::Vertex<BufferIndex, ImageIndex> {
 
     Type _type = Type::NONE;
     QueueType _queueType = QueueType::GRAPHICS;
+    // present pass that acquires a swapchain image, run before any batch is recorded as later passes need the image
+    bool _acquire = false;
 
     auto inputResourceIndex(u32 i) const -> u32;
     auto outputResourceIndex(u32 i) const -> u32;
@@ -196,48 +297,47 @@ class RenderPass : public ende::graph::Vertex<BufferIndex, ImageIndex> {
         Edge value;
         i32 offset = 0;
     };
-    static auto resolvePushConstants(const RenderGraph &graph, PushData data, std::span<const DeferredPushConstant> deferredConstants) -> std::expected<PushData, RenderGraphError>;
 
     void mergeAccesses();
 
+    void setAllocationCounter(u64 *counter);
+    // takes the storage of a pass from an earlier build, containers are cleared but keep their capacity
+    void reuseStorage(RenderPass &other);
+
     PipelineHandle _pipeline = {};
     bool _manualPipeline = false;
+    u64 _costHint = 0;
 
-    std::vector<DeferredPushConstant> _deferredPushConstants;
+    PassVector<DeferredPushConstant> _deferredPushConstants = {};
     PushData _pushData = {};
     std::function<std::expected<bool, RenderGraphError>(CommandHandle, RenderGraph &, const PushData &)> _callback = {};
-    std::vector<ResourceAccess> _accesses = {};
+    PassVector<ResourceAccess> _accesses = {};
 
     ende::math::uint2 _dimensions = {0, 0};
     struct Attachment {
         i32 index = -1;
         ImageLayout layout = ImageLayout::UNDEFINED;
         ClearValue clearColor = std::to_array({0.f, 0.f, 0.f, 1.f});
+        AttachmentHint hint = {};
     };
-    std::vector<Attachment> _colourAttachments = {};
+    PassVector<Attachment> _colourAttachments = {};
     Attachment _depthAttachment = {};
 
-    std::vector<canta::Attachment> _renderingColourAttachments = {};
+    PassVector<canta::Attachment> _renderingColourAttachments = {};
     canta::Attachment _renderingDepthAttachment = {};
 
-    struct Barrier {
-        i32 index = 0;
-        i32 passIndex = 0;
-        PipelineStage srcStage = PipelineStage::TOP;
-        PipelineStage dstStage = PipelineStage::BOTTOM;
-        Access srcAccess = Access::NONE;
-        Access dstAccess = Access::NONE;
-        ImageLayout srcLayout = ImageLayout::UNDEFINED;
-        ImageLayout dstLayout = ImageLayout::UNDEFINED;
-        QueueType srcQueue = QueueType::NONE;
-        QueueType dstQueue = QueueType::NONE;
-    };
-    std::vector<Barrier> _barriers = {};
-    std::vector<std::pair<i32, QueueType>> _queueWaits = {};
+    PassVector<Barrier> _barriers = {};
+    PassVector<std::pair<i32, QueueType>> _queueWaits = {};
+    // indices into the graphs event barriers set after and waited on before this pass
+    PassVector<u32> _eventSignals = {};
+    PassVector<u32> _eventWaits = {};
 
     RenderGroup _group = {};
 
     std::string _name = {};
+
+    // index of the vertex this pass was compiled from
+    u32 _vertexIndex = 0;
 };
 
 class PassBuilder {
@@ -252,12 +352,14 @@ class PassBuilder {
 
     auto pipeline(const PipelineHandle &pipeline) -> PassBuilder &;
     auto setManualPipeline(bool state) -> PassBuilder &;
+    auto setCostHint(u64 nanoseconds) -> PassBuilder &;
 
-    auto read(BufferIndex index, Access access, PipelineStage stage) -> std::expected<BufferInfo, RenderGraphError>;
-    auto read(ImageIndex index, Access access, PipelineStage stage, ImageLayout layout) -> std::expected<ImageInfo, RenderGraphError>;
+    // accesses to disjoint ranges of one buffer or subresources of one image dont synchronise with each other
+    auto read(BufferIndex index, Access access, PipelineStage stage, const BufferRange &range = {}) -> std::expected<BufferInfo, RenderGraphError>;
+    auto read(ImageIndex index, Access access, PipelineStage stage, ImageLayout layout, const ImageSubresource &subresource = {}) -> std::expected<ImageInfo, RenderGraphError>;
 
-    auto write(BufferIndex index, Access access, PipelineStage stage) -> std::expected<BufferInfo, RenderGraphError>;
-    auto write(ImageIndex index, Access access, PipelineStage stage, ImageLayout layout) -> std::expected<ImageInfo, RenderGraphError>;
+    auto write(BufferIndex index, Access access, PipelineStage stage, const BufferRange &range = {}) -> std::expected<BufferInfo, RenderGraphError>;
+    auto write(ImageIndex index, Access access, PipelineStage stage, ImageLayout layout, const ImageSubresource &subresource = {}) -> std::expected<ImageInfo, RenderGraphError>;
 
     template <typename T, typename U, typename... Args>
     void unpack(RenderPass::PushData &dst, i32 &i, const T &t, const U &u, const Args &...args) {
@@ -321,21 +423,21 @@ class PassBuilder {
     // protected:
 
     auto addColourRead(ImageIndex index) -> PassBuilder &;
-    auto addColourWrite(ImageIndex index, const ClearValue &clearColor = std::to_array({0.f, 0.f, 0.f, 1.f})) -> PassBuilder &;
+    auto addColourWrite(ImageIndex index, const ClearValue &clearColor = std::to_array({0.f, 0.f, 0.f, 1.f}), const AttachmentHint &hint = {}) -> PassBuilder &;
 
     auto addDepthRead(ImageIndex index) -> PassBuilder &;
-    auto addDepthWrite(ImageIndex index, const ClearValue &clearColor = DepthClearValue{.depth = 1.f, .stencil = 0}) -> PassBuilder &;
+    auto addDepthWrite(ImageIndex index, const ClearValue &clearColor = DepthClearValue{.depth = 1.f, .stencil = 0}, const AttachmentHint &hint = {}) -> PassBuilder &;
 
-    auto addStorageImageRead(ImageIndex index, PipelineStage stage = PipelineStage::NONE) -> PassBuilder &;
-    auto addStorageImageWrite(ImageIndex index, PipelineStage stage = PipelineStage::NONE) -> PassBuilder &;
+    auto addStorageImageRead(ImageIndex index, PipelineStage stage = PipelineStage::NONE, const ImageSubresource &subresource = {}) -> PassBuilder &;
+    auto addStorageImageWrite(ImageIndex index, PipelineStage stage = PipelineStage::NONE, const ImageSubresource &subresource = {}) -> PassBuilder &;
 
-    auto addStorageBufferRead(BufferIndex index, PipelineStage stage = PipelineStage::NONE) -> PassBuilder &;
-    auto addStorageBufferWrite(BufferIndex index, PipelineStage stage = PipelineStage::NONE) -> PassBuilder &;
+    auto addStorageBufferRead(BufferIndex index, PipelineStage stage = PipelineStage::NONE, const BufferRange &range = {}) -> PassBuilder &;
+    auto addStorageBufferWrite(BufferIndex index, PipelineStage stage = PipelineStage::NONE, const BufferRange &range = {}) -> PassBuilder &;
 
-    auto addSampledRead(ImageIndex index, PipelineStage stage = PipelineStage::NONE) -> PassBuilder &;
+    auto addSampledRead(ImageIndex index, PipelineStage stage = PipelineStage::NONE, const ImageSubresource &subresource = {}) -> PassBuilder &;
 
-    auto addBlitRead(ImageIndex index) -> PassBuilder &;
-    auto addBlitWrite(ImageIndex index) -> PassBuilder &;
+    auto addBlitRead(ImageIndex index, const ImageSubresource &subresource = {}) -> PassBuilder &;
+    auto addBlitWrite(ImageIndex index, const ImageSubresource &subresource = {}) -> PassBuilder &;
 
     auto addTransferRead(ImageIndex index) -> PassBuilder &;
     auto addTransferWrite(ImageIndex index) -> PassBuilder &;
@@ -366,13 +468,13 @@ class ComputePass : public PassBuilder {
   public:
     ComputePass(RenderGraph *graph, u32 index);
 
-    auto addStorageImageRead(ImageIndex index) -> ComputePass &;
-    auto addStorageImageWrite(ImageIndex index) -> ComputePass &;
+    auto addStorageImageRead(ImageIndex index, const ImageSubresource &subresource = {}) -> ComputePass &;
+    auto addStorageImageWrite(ImageIndex index, const ImageSubresource &subresource = {}) -> ComputePass &;
 
-    auto addStorageBufferRead(BufferIndex index) -> ComputePass &;
-    auto addStorageBufferWrite(BufferIndex index) -> ComputePass &;
+    auto addStorageBufferRead(BufferIndex index, const BufferRange &range = {}) -> ComputePass &;
+    auto addStorageBufferWrite(BufferIndex index, const BufferRange &range = {}) -> ComputePass &;
 
-    auto addSampledRead(ImageIndex index) -> ComputePass &;
+    auto addSampledRead(ImageIndex index, const ImageSubresource &subresource = {}) -> ComputePass &;
 
     template <typename... Args>
     auto pushConstants(Args &&...args) -> ComputePass & {
@@ -391,18 +493,18 @@ class GraphicsPass : public PassBuilder {
     GraphicsPass(RenderGraph *graph, u32 index);
 
     auto addColourRead(ImageIndex index) -> GraphicsPass &;
-    auto addColourWrite(ImageIndex index, const ClearValue &clearColor = std::to_array({0.f, 0.f, 0.f, 1.f})) -> GraphicsPass &;
+    auto addColourWrite(ImageIndex index, const ClearValue &clearColor = std::to_array({0.f, 0.f, 0.f, 1.f}), const AttachmentHint &hint = {}) -> GraphicsPass &;
 
     auto addDepthRead(ImageIndex index) -> GraphicsPass &;
-    auto addDepthWrite(ImageIndex index, const ClearValue &clearColor = DepthClearValue{.depth = 1.f, .stencil = 0}) -> GraphicsPass &;
+    auto addDepthWrite(ImageIndex index, const ClearValue &clearColor = DepthClearValue{.depth = 1.f, .stencil = 0}, const AttachmentHint &hint = {}) -> GraphicsPass &;
 
-    auto addStorageImageRead(ImageIndex index, PipelineStage stage) -> GraphicsPass &;
-    auto addStorageImageWrite(ImageIndex index, PipelineStage stage) -> GraphicsPass &;
+    auto addStorageImageRead(ImageIndex index, PipelineStage stage, const ImageSubresource &subresource = {}) -> GraphicsPass &;
+    auto addStorageImageWrite(ImageIndex index, PipelineStage stage, const ImageSubresource &subresource = {}) -> GraphicsPass &;
 
-    auto addStorageBufferRead(BufferIndex index, PipelineStage stage) -> GraphicsPass &;
-    auto addStorageBufferWrite(BufferIndex index, PipelineStage stage) -> GraphicsPass &;
+    auto addStorageBufferRead(BufferIndex index, PipelineStage stage, const BufferRange &range = {}) -> GraphicsPass &;
+    auto addStorageBufferWrite(BufferIndex index, PipelineStage stage, const BufferRange &range = {}) -> GraphicsPass &;
 
-    auto addSampledRead(ImageIndex index, PipelineStage stage) -> GraphicsPass &;
+    auto addSampledRead(ImageIndex index, PipelineStage stage, const ImageSubresource &subresource = {}) -> GraphicsPass &;
 
     template <typename... Args>
     auto pushConstants(Args &&...args) -> GraphicsPass & {
@@ -592,6 +694,8 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
     struct Resource {
         ResourceInfo info = {};
         ResourceAccess initialAccess = {};
+        // last use of whatever shared memory with an aliased resource, kept apart so it doesn't change the structural hash
+        std::optional<ResourceAccess> aliasedAccess = std::nullopt;
         std::string name = {};
     };
 
@@ -599,6 +703,14 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
         Device *device;
         std::shared_ptr<ende::thread::ThreadPool> threadPool = nullptr;
         bool multiQueue = false;
+        bool transientAliasing = false;
+        bool splitBarriers = false;
+        bool parallelRecording = false;
+        bool reorderPasses = false;
+        bool costScheduling = false;
+        bool retained = false;
+        // size of the per frame parameter buffer, 0 to not create one
+        u32 parameterSize = 0;
         std::string_view name = {};
     };
 
@@ -672,7 +784,7 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
 
     template <typename... Args>
     auto host(const std::string_view name) -> Host<Args...> {
-        auto &pass = addVertex();
+        auto &pass = newPass();
         pass._type = RenderPass::Type::HOST;
         pass._name = name;
         const auto builder = Host<Args...>(this, vertexCount() - 1);
@@ -690,6 +802,12 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
 
     auto compile() -> std::expected<bool, RenderGraphError>;
 
+    // force the next compile to rebuild even if the graph is unchanged
+    void invalidate() {
+        _compiledHash = 0;
+        _retainedKeys = {};
+    }
+
     auto run(std::span<SemaphorePair> waits = {}, std::span<SemaphorePair> signals = {}, bool async = true) -> std::expected<bool, RenderGraphError>;
 
     void reset(bool keepResources = false);
@@ -706,6 +824,8 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
         std::string name = {};
         QueueType queue = QueueType::NONE;
         Timer timer = {};
+        // vertex index of the timed pass, -1 when timing a group
+        i32 pass = -1;
     };
     auto timers() -> std::span<TimerInfo> {
         if (_timers[_device->flyingIndex()].size() < _timerCount)
@@ -724,6 +844,25 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
         return {_statistics[_device->flyingIndex()].data(), _statsCount};
     }
 
+    struct CpuTiming {
+        // build, compile, record, submit, host or run
+        std::string_view category = {};
+        std::string name = {};
+        // std::chrono::steady_clock time in nanoseconds
+        u64 start = 0;
+        u64 duration = 0;
+        // passes recorded in parallel overlap so are kept apart by the thread that recorded them
+        u32 thread = 0;
+    };
+    void setCpuProfiling(const bool state) { _cpuProfiling = state; }
+    auto cpuProfiling() const -> bool { return _cpuProfiling; }
+    // cpu timings of building, compiling and running a completed frame, 0 is the most recent. host passes are added to
+    // the frame that is running when they finish
+    auto cpuTimings(u32 framesAgo = 0) const -> std::span<const CpuTiming>;
+    // frames completed with profiling enabled, only the last few are kept for cpuTimings()
+    auto cpuFrameCount() const -> u32 { return _cpuFrame; }
+    static constexpr u32 CPU_TIMING_FRAMES = 4;
+
     enum class QueryMode {
         DISABLED,
         PER_PASS,
@@ -739,12 +878,63 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
     void setMultiQueue(const bool state) { _multiQueue = state; }
     auto multiQueue() const -> bool { return _multiQueue; }
 
+    // place graph owned resources with disjoint lifetimes in shared memory. resources used off the graphics queue are never aliased
+    void setTransientAliasing(const bool state) { _transientAliasing = state; }
+    auto transientAliasing() const -> bool { return _transientAliasing; }
+
+    // signal barriers with an event after the producing pass and wait right before the consumer so passes in between can overlap
+    void setSplitBarriers(const bool state) { _splitBarriers = state; }
+    auto splitBarriers() const -> bool { return _splitBarriers; }
+
+    // record each command buffer on the thread pool. falls back to serial recording when timing or stats are PER_GROUP
+    void setParallelRecording(const bool state) { _parallelRecording = state; }
+    auto parallelRecording() const -> bool { return _parallelRecording; }
+    // fewest passes worth giving their own command buffer when splitting a run on one queue for parallel recording
+    static constexpr u32 MIN_BATCH_PASSES = 4;
+
+    // reorder passes within dependency levels to group queues and shared reads. kept only if it doesnt add barriers
+    void setReorderPasses(const bool state) { _reorderPasses = state; }
+    auto reorderPasses() const -> bool { return _reorderPasses; }
+
+    // balance compute passes between graphics and async compute using cost hints or PER_PASS timings. requires multiQueue,
+    // measured timings are sampled each compile and recompile the graph when a pass cost shifts
+    void setCostScheduling(const bool state) { _costScheduling = state; }
+    auto costScheduling() const -> bool { return _costScheduling; }
+
+    // keep recorded command buffers and replay them while the compiled graph, push constants and resources are unchanged.
+    // pass callbacks are assumed to record the same commands each frame, call invalidate() when they dont. ignored when
+    // timing or stats are PER_GROUP
+    void setRetained(const bool state) { _retained = state; }
+    auto retained() const -> bool { return _retained; }
+
+    // persistently mapped buffer for the current frame. push its address once and write per frame values with data()
+    // so retained command buffers dont need re-recording
+    auto parameterBuffer() const -> BufferHandle { return _parameterBuffers[_device->flyingIndex()]; }
+
     struct Stats {
         u32 passes = 0;
         u32 commandBuffers = 0;
         u32 resources = 0;
         u32 images = 0;
         u32 buffers = 0;
+        // bytes backing aliased resources vs bytes needed to allocate them separately
+        u64 transientMemory = 0;
+        u64 naiveTransientMemory = 0;
+        u32 barriers = 0;
+        // read after read barriers merged into an earlier barrier
+        u32 elidedBarriers = 0;
+        // barriers moved into set and wait event pairs
+        u32 splitBarriers = 0;
+        // barriers of the sorted order and of the order used after reordering, counted before barriers are split
+        u32 barriersBeforeReorder = 0;
+        u32 barriersAfterReorder = 0;
+        u32 queueSubmits = 0;
+        // command buffers recorded by the last run, 0 when retained command buffers were replayed
+        u32 recordedBatches = 0;
+        // graph owned buffers and images released by reset() and not yet reused
+        u32 pooledResources = 0;
+        // heap allocations made for pass storage since the last reset()
+        u64 passAllocations = 0;
     };
     auto stats() const -> Stats;
 
@@ -765,36 +955,134 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
     [[nodiscard]] auto getResourceIndices(std::span<const RenderPass> passes) const -> std::vector<std::pair<u32, u32>>;
 
     [[nodiscard]] auto buildDependencyLevels(std::span<const RenderPass> passes) const -> std::expected<std::vector<std::vector<u32>>, RenderGraphError>;
+    void updatePassCosts();
+    void scheduleAsyncCompute(std::span<RenderPass> passes, std::span<const std::vector<u32>> levels) const;
 
+    void convertBarriers(std::span<const RenderPass::Barrier> barriers, const std::function<void(std::span<const ImageBarrier>, std::span<const BufferBarrier>)> &func) const;
     void submitBarriers(CommandHandle commands, std::span<const RenderPass::Barrier> barriers) const;
+    void signalBarriers(CommandHandle commands, VkEvent event, std::span<const RenderPass::Barrier> barriers) const;
+    void waitBarriers(CommandHandle commands, VkEvent event, std::span<const RenderPass::Barrier> barriers) const;
+
+    // contiguous passes on one queue recorded into a single command buffer
+    struct RecordBatch {
+        u32 first = 0;
+        u32 last = 0;
+        QueueType queue = QueueType::NONE;
+        // host or present pass whose barriers are recorded at the end of the batch
+        i32 trailingPass = -1;
+        u32 queryIndex = 0;
+        CommandHandle commands = {};
+        std::expected<bool, RenderGraphError> result = true;
+    };
+    auto buildRecordBatches() const -> std::vector<RecordBatch>;
+    auto recordBatch(const RecordBatch &batch, std::span<const VkEvent> events) -> std::expected<bool, RenderGraphError>;
+    [[nodiscard]] auto retainedKey() const -> u64;
+
+    // steady clock nanoseconds, 0 when profiling is disabled
+    auto cpuTime() const -> u64;
+    void addCpuTiming(std::string_view category, std::string_view name, u64 start);
 
-    void startTimer(CommandHandle commands, u32 index, std::string_view name, QueueType queue);
+    void startTimer(CommandHandle commands, u32 index, std::string_view name, QueueType queue, i32 pass = -1);
     void endTimer(CommandHandle commands, u32 index);
 
     void startStats(CommandHandle commands, u32 index, std::string_view name, QueueType queue);
     void endStats(CommandHandle commands, u32 index);
 
+    [[nodiscard]] auto structuralHash() -> u64;
+    auto patchCompiledPasses() -> std::expected<bool, RenderGraphError>;
+
+    auto schedulePasses() -> std::expected<bool, RenderGraphError>;
+    void buildAccessTimelines();
     void buildBarriers();
+    void buildSplitBarriers();
     void buildResources();
+    void releaseResource(Resource &resource);
+    auto acquireBuffer(const BufferInfo &info) -> BufferHandle;
+    auto acquireImage(const ImageInfo &info) -> ImageHandle;
+    void buildTransientResources();
     auto buildRenderAttachments() -> std::expected<bool, RenderGraphError>;
+    auto newPass() -> RenderPass &;
+    // writes the addresses and indices of deferred push constants into the compiled passes push data
+    auto resolvePushConstants() -> std::expected<bool, RenderGraphError>;
 
     static u32 s_graphIndex;
 
     Device *_device = nullptr;
     std::shared_ptr<ende::thread::ThreadPool> _threadPool = nullptr;
+    std::shared_ptr<HostPassExecutor> _hostExecutor = nullptr;
     bool _multiQueue = false;
+    bool _transientAliasing = false;
+    bool _splitBarriers = false;
+    bool _parallelRecording = false;
+    bool _reorderPasses = false;
+    bool _costScheduling = false;
+    bool _retained = false;
     u32 _graphIndex = 0;
     std::string _name = {};
 
     std::vector<RenderPass> _orderedPasses = {};
+    // passes from the last build kept at reset() so the next build reuses their storage
+    std::vector<RenderPass> _passPool = {};
+    // heap allocated so the pointer held by pass allocators survives the graph being moved
+    std::unique_ptr<u64> _passAllocations = std::make_unique<u64>(0);
+    // hash of the graph _orderedPasses was compiled from
+    u64 _compiledHash = 0;
 
     i32 _rootEdge = -1;
     i32 _rootPass = -1;
 
-    // VmaPool _resourcePool = {};
-    // u32 _poolSize = 0;
     std::vector<Resource> _resources = {};
 
+    // physical resources handed back at reset and matched by description on later compiles. only reused once the frame
+    // that last used them is out of flight
+    template <typename T>
+    struct PooledResource {
+        T handle = {};
+        u64 frame = 0;
+    };
+    std::unordered_multimap<u64, PooledResource<BufferHandle>> _bufferPool = {};
+    std::unordered_multimap<u64, PooledResource<ImageHandle>> _imagePool = {};
+    // accesses of each resource in pass order, a pass appears once per disjoint subresource or byte range it touches
+    std::vector<std::vector<Access>> _resourceAccesses = {};
+
+    struct TransientHeap {
+        std::shared_ptr<VmaAllocation_T> memory = nullptr;
+        u64 size = 0;
+        u32 memoryType = 0;
+    };
+    // per frame so in flight frames dont alias each other. 0 = buffers, 1 = images
+    std::array<std::array<TransientHeap, 2>, FRAMES_IN_FLIGHT> _transientHeaps = {};
+    struct AliasedResource {
+        VmaAllocation memory = VK_NULL_HANDLE;
+        u64 offset = 0;
+        BufferHandle buffer = {};
+        ImageHandle image = {};
+    };
+    // resources created in each frames heaps, reused while their placement and create info are unchanged
+    std::array<std::vector<AliasedResource>, FRAMES_IN_FLIGHT> _aliasedResources = {};
+    u64 _transientMemory = 0;
+    u64 _naiveTransientMemory = 0;
+    u32 _elidedBarriers = 0;
+    u32 _barriersBeforeReorder = 0;
+    u32 _barriersAfterReorder = 0;
+    u32 _submitCount = 0;
+    u32 _recordedBatches = 0;
+    // device frame of the last run, resources released after it may still be in use until it completes
+    u64 _lastRunFrame = 0;
+
+    // last measured gpu time of each pass keyed by its vertex index and name, so passes sharing a name are kept apart
+    // and a pass only picks up the cost of the same pass from an earlier build
+    std::unordered_map<u64, u64> _passCosts = {};
+    // bumped when _passCosts changes enough to reschedule, part of the structural hash
+    u64 _costEpoch = 0;
+
+    struct EventBarrier {
+        i32 signalPass = -1;
+        i32 waitPass = -1;
+        std::vector<RenderPass::Barrier> barriers = {};
+    };
+    std::vector<EventBarrier> _eventBarriers = {};
+
     std::vector<SemaphorePair> _importedWaits = {};
 
     i32 _groupId = 0;
@@ -808,8 +1096,30 @@ class RenderGraph : public ende::graph::Graph<RenderPass> {
     QueryMode _statsMode = QueryMode::DISABLED;
     std::array<std::vector<StatisticInfo>, FRAMES_IN_FLIGHT> _statistics = {};
 
+    bool _cpuProfiling = false;
+    // set by reset() so compile() can time building the graph
+    u64 _cpuBuildStart = 0;
+    std::vector<CpuTiming> _cpuFrameTimings = {};
+    // host passes finish on the executors threads, possibly after run() has returned
+    struct HostCpuTimings {
+        std::mutex mutex = {};
+        std::vector<CpuTiming> timings = {};
+    };
+    std::shared_ptr<HostCpuTimings> _hostCpuTimings = std::make_shared<HostCpuTimings>();
+    // written by the recording threads at their own pass index
+    std::vector<CpuTiming> _passCpuTimings = {};
+    u32 _cpuFrame = 0;
+    std::array<std::vector<CpuTiming>, CPU_TIMING_FRAMES> _cpuTimings = {};
+
     // 0 = graphics, 1 = compute, 2 = transfer
     std::array<std::array<CommandPool, 3>, FRAMES_IN_FLIGHT> _commandPools = {};
+    // one pool per record batch so batches can be recorded from different threads
+    std::array<std::vector<CommandPool>, FRAMES_IN_FLIGHT> _recordingPools = {};
+    std::array<EventPool, FRAMES_IN_FLIGHT> _eventPools = {};
+    // batches recorded with oneTimeSubmit off and the key they were recorded with, 0 when not valid
+    std::array<std::vector<RecordBatch>, FRAMES_IN_FLIGHT> _retainedBatches = {};
+    std::array<u64, FRAMES_IN_FLIGHT> _retainedKeys = {};
+    std::array<BufferHandle, FRAMES_IN_FLIGHT> _parameterBuffers = {};
     SemaphoreHandle _cpuTimeline = {};
 };
 
@@ -2,7 +2,10 @@
 #define CANTA_RESOURCELIST_H
 
 #include <Ende/platform.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
 #include <functional>
 #include <memory>
@@ -13,109 +16,152 @@
 
 namespace canta {
 
+// storage for one resource and its bookkeeping, lives in a chunk owned by the list so its address never changes
+template <typename T>
+struct ResourceSlot {
+    T resource = {};
+    std::atomic<i32> count = 0;
+    i32 index = -1;
+    // bumped each time the slot is freed, handles and refs taken before then no longer match. checked by valid() on
+    // any thread while clearQueue frees the slot
+    std::atomic<u32> generation = 0;
+    // fixed place in the chunks, names the slot in the free list
+    u32 position = 0;
+    // position + 1 of the next free slot, 0 ends the list
+    std::atomic<u32> nextFree = 0;
+    ResourceSlot *nextReleased = nullptr;
+    u64 releaseTimeline = 0;
+};
+
+// non owning handle of a slot and the generation of the slot when it was taken. dereferencing is a single pointer load
+// with no reference counting so it suits hot paths like recording commands, a Handle must keep the resource alive
 template <typename T, typename List>
-class Handle {
+class Ref {
   public:
-    struct Data {
-        i32 index = -1;
-        std::atomic<i32> count = 0;
-        std::function<void(i32)> deleter = {};
-    };
+    Ref() = default;
+
+    auto operator==(const Ref &rhs) const noexcept -> bool = default;
+
+    // false once the slot has been freed, even if a new resource has taken it
+    explicit operator bool() const noexcept {
+        return _slot && _slot->generation.load(std::memory_order_acquire) == _generation;
+    }
+
+    auto operator*() const noexcept -> T & {
+        assert(*this);
+        return _slot->resource;
+    }
 
-    static auto create(List *list, std::weak_ptr<Data> data) -> Handle {
+    auto operator->() const noexcept -> T * {
+        assert(*this);
+        return &_slot->resource;
+    }
+
+    auto index() const -> u32 { return _slot ? _slot->index : 0; }
+    auto generation() const -> u32 { return _generation; }
+
+  private:
+    friend List;
+
+    ResourceSlot<T> *_slot = nullptr;
+    u32 _generation = 0;
+};
+
+// reference counted handle to a slot. handles must not outlive the list that created them
+template <typename T, typename List>
+class Handle {
+  public:
+    static auto create(List *list, ResourceSlot<T> *slot) -> Handle {
         Handle handle = {};
         handle._list = list;
-        handle._data = data;
-        handle._hash = s_hash++;
+        handle._slot = slot;
+        handle._generation = slot->generation.load(std::memory_order_relaxed);
+        handle._hash = s_hash.fetch_add(1, std::memory_order_relaxed);
         return handle;
     }
 
     Handle() = default;
     ~Handle() {
-        decrement(_data);
+        decrement();
     }
 
     Handle(const Handle &rhs)
         : _list(rhs._list),
-          _data(rhs._data),
+          _slot(rhs._slot),
+          _generation(rhs._generation),
           _hash(rhs._hash) {
-        increment(_data);
+        increment();
     }
 
     Handle(Handle &&rhs) noexcept {
-        std::swap(_list, rhs._list);
-        std::swap(_data, rhs._data);
-        std::swap(_hash, rhs._hash);
+        swap(rhs);
     }
 
     auto operator=(const Handle &rhs) -> Handle & {
         if (this == &rhs)
             return *this;
 
-        auto tmp = _data;
-        _list = rhs._list;
-        _data = rhs._data;
-        _hash = rhs._hash;
-        increment(_data);
-        decrement(tmp);
+        Handle tmp = rhs;
+        swap(tmp);
         return *this;
     }
 
     auto operator=(Handle &&rhs) noexcept -> Handle & {
-        std::swap(_list, rhs._list);
-        std::swap(_data, rhs._data);
-        std::swap(_hash, rhs._hash);
+        swap(rhs);
         return *this;
     }
 
     auto operator==(const Handle &rhs) const noexcept -> bool {
-        return _list == rhs._list && _data.lock() == rhs._data.lock();
+        return _list == rhs._list && _slot == rhs._slot && _generation == rhs._generation;
     }
 
     explicit operator bool() const noexcept {
-        auto d = _data.lock();
-        return _list && (!d || d->index >= 0);
+        return _list && _slot;
     }
 
     auto operator*() noexcept -> T & {
-        auto d = _data.lock();
-        assert(_list && d);
-        return _list->_resources[d->index]->first;
+        assert(_list && valid());
+        return _slot->resource;
     }
 
     auto operator->() noexcept -> T * {
-        auto d = _data.lock();
-        assert(_list && d);
-        return &_list->_resources[d->index]->first;
+        assert(_list && valid());
+        return &_slot->resource;
     }
 
     auto operator*() const noexcept -> const T & {
-        auto d = _data.lock();
-        assert(_list && d);
-        return _list->_resources[d->index]->first;
+        assert(_list && valid());
+        return _slot->resource;
     }
 
     auto operator->() const noexcept -> const T * {
-        auto d = _data.lock();
-        assert(_list && d);
-        return &_list->_resources[d->index]->first;
+        assert(_list && valid());
+        return &_slot->resource;
     }
 
     auto index() const -> i32 {
-        if (auto d = _data.lock())
-            return d->index;
+        if (valid())
+            return _slot->index;
         return -1;
     }
 
     auto count() const -> i32 {
-        if (auto d = _data.lock())
-            return d->count;
+        if (valid())
+            return _slot->count;
         return 0;
     }
 
-    auto release() -> Data * {
-        auto tmp = _data;
-        _data = nullptr;
+    auto ref() const -> Ref<T, List> {
+        if (!_list)
+            return {};
+        return _list->getRef(index());
+    }
+
+    // gives up the reference without decrementing it
+    auto release() -> ResourceSlot<T> * {
+        auto tmp = valid() ? _slot : nullptr;
+        _list = nullptr;
+        _slot = nullptr;
         return tmp;
     }
 
@@ -124,59 +170,61 @@ class Handle {
   private:
     friend List;
 
-    static inline auto increment(std::weak_ptr<Data> data) -> i32 {
-        if (auto d = data.lock()) {
-            return ++d->count;
-        }
-        return -1;
+    // the slot outlives the handle but may have been freed by List::clearAll and taken again
+    auto valid() const -> bool {
+        return _slot && _slot->generation.load(std::memory_order_acquire) == _generation;
     }
 
-    static inline auto decrement(std::weak_ptr<Data> data) -> i32 {
-        if (auto d = data.lock()) {
-            const i32 newCount = --d->count;
-            if (newCount < 1) {
-                d->deleter(d->index);
-            }
-            return newCount;
-        }
-        return -1;
+    void swap(Handle &rhs) noexcept {
+        std::swap(_list, rhs._list);
+        std::swap(_slot, rhs._slot);
+        std::swap(_generation, rhs._generation);
+        std::swap(_hash, rhs._hash);
+    }
+
+    void increment() {
+        if (valid())
+            ++_slot->count;
+    }
+
+    void decrement() {
+        if (valid() && --_slot->count < 1)
+            _list->destroy(_slot);
     }
 
     List *_list = nullptr;
-    std::weak_ptr<Data> _data = {};
+    ResourceSlot<T> *_slot = nullptr;
+    u32 _generation = 0;
 
     u32 _hash = 0;
-    static u32 s_hash;
+    static std::atomic<u32> s_hash;
 };
 
 template <typename T>
 class ResourceList {
   public:
     using ResourceHandle = Handle<T, ResourceList>;
-    using ResourceData = ResourceHandle::Data;
+    using ResourceRef = Ref<T, ResourceList>;
+    using Slot = ResourceSlot<T>;
+
+    // chunk n holds CHUNK_SIZE << n slots
+    static constexpr u32 CHUNK_SIZE = 64;
+    static constexpr u32 MAX_CHUNKS = 24;
 
     ResourceList() = default;
 
     ~ResourceList() {
         clearAll();
+        for (auto &chunk : _chunks)
+            delete[] chunk.load();
     }
 
     ResourceList(ResourceList &&rhs) noexcept {
-        std::swap(_resources, rhs._resources);
-        std::swap(_freeResources, rhs._freeResources);
-        std::swap(_destroyQueue, rhs._destroyQueue);
-        std::swap(_destructionDelay, rhs._destructionDelay);
-        std::swap(_getTimelineValue, rhs._getTimelineValue);
-        std::swap(_logger, rhs._logger);
+        exchange(rhs);
     }
 
     auto operator=(ResourceList &&rhs) noexcept -> ResourceList & {
-        std::swap(_resources, rhs._resources);
-        std::swap(_freeResources, rhs._freeResources);
-        std::swap(_destroyQueue, rhs._destroyQueue);
-        std::swap(_destructionDelay, rhs._destructionDelay);
-        std::swap(_getTimelineValue, rhs._getTimelineValue);
-        std::swap(_logger, rhs._logger);
+        exchange(rhs);
         return *this;
     }
 
@@ -200,115 +248,273 @@ class ResourceList {
         _getTimelineValue = getTimelineValue;
     }
 
+    // lock free while there are free slots, only growing by a chunk takes the lock
     [[nodiscard]] auto allocate() -> ResourceHandle {
-        i32 index = -1;
-        std::unique_lock lock(_mutex);
-        if (!_freeResources.empty()) {
-            index = _freeResources.back();
-            _freeResources.pop_back();
-            _resources[index] = std::make_unique<std::pair<T, std::shared_ptr<ResourceData>>>();
-            _resources[index]->second = std::make_shared<ResourceData>();
-            _resources[index]->second->index = index;
-            _resources[index]->second->deleter = [this](i32 index) {
-                std::unique_lock lock(_mutex);
-                const auto timelineValue = _getTimelineValue();
-                _destroyQueue.emplace_back(timelineValue, index);
-                if (const auto logger = _logger.lock())
-                    logger->info("Resource {} at index {} destroyed", typeid(T).name(), index);
-            };
-        } else {
-            index = _resources.size();
-            _resources.emplace_back(std::make_unique<std::pair<T, std::shared_ptr<ResourceData>>>());
-            _resources[index]->second = std::make_shared<ResourceData>();
-            _resources.back()->second->index = index;
-            _resources.back()->second->deleter = [this](i32 index) {
-                std::unique_lock lock(_mutex);
-                const auto timelineValue = _getTimelineValue();
-                _destroyQueue.emplace_back(timelineValue, index);
-                if (const auto logger = _logger.lock())
-                    logger->info("Resource {} at index {} destroyed", typeid(T).name(), index);
-            };
-        }
-        return getHandle(index);
+        auto *slot = popFree();
+        if (!slot)
+            slot = grow();
+        slot->count = 1;
+        return ResourceHandle::create(this, slot);
     }
 
+    // the handle keeps its slot and takes a new index, the resource it held moves to the old index and is destroyed
+    // once the delay has passed. every copy of the handle sees the new resource
     [[nodiscard]] auto reallocate(ResourceHandle handle) -> ResourceHandle {
-        i32 oldIndex = handle.index();
         auto newHandle = allocate();
         std::unique_lock lock(_mutex);
-        auto newIndex = newHandle.index();
-        _resources[newIndex].swap(_resources[oldIndex]);
-        _resources[oldIndex]->first = std::move(_resources[newIndex]->first);
-        _resources[newIndex]->second->index = newIndex;
-        _resources[oldIndex]->second->index = oldIndex;
-        return getHandle(newIndex);
+        auto *oldSlot = handle._slot;
+        auto *newSlot = newHandle._slot;
+        std::swap(oldSlot->resource, newSlot->resource);
+        std::swap(oldSlot->index, newSlot->index);
+        _slots[oldSlot->index] = oldSlot;
+        _slots[newSlot->index] = newSlot;
+        return handle;
     }
 
+    // handles keep their resources and exchange indices
     auto swap(ResourceHandle oldHandle, ResourceHandle newHandle) -> ResourceHandle {
-        i32 oldIndex = oldHandle.index();
-        i32 newIndex = newHandle.index();
         std::unique_lock lock(_mutex);
-        _resources[newIndex].swap(_resources[oldIndex]);
-        std::swap(_resources[oldIndex]->second->index, _resources[newIndex]->second->index);
+        auto *oldSlot = oldHandle._slot;
+        auto *newSlot = newHandle._slot;
+        std::swap(oldSlot->index, newSlot->index);
+        _slots[oldSlot->index] = oldSlot;
+        _slots[newSlot->index] = newSlot;
         return oldHandle;
     }
 
+    // only one thread may clear at a time, handles can keep being dropped meanwhile
     void clearQueue(std::function<void(T &)> func = [](auto &resource) { resource = {}; }) {
-        std::unique_lock lock(_mutex);
-        const auto timelineValue = _getTimelineValue();
-        for (auto it = _destroyQueue.begin(); it != _destroyQueue.end(); ++it) {
-            if ((it->first + _destructionDelay) < timelineValue) {
-                _resources[it->second]->second->deleter = {};
-                func(_resources[it->second]->first);
-                if (const auto logger = _logger.lock())
-                    logger->info("GPU Resource {} at index {} destroyed. Timeline({} <= {})", typeid(T).name(), it->second, it->first, timelineValue);
-                _freeResources.push_back(it->second);
-                _destroyQueue.erase(it--);
+        u32 destroyed = 0;
+        {
+            std::unique_lock lock(_mutex);
+            u32 queued = 0;
+            for (auto *slot = _released.exchange(nullptr, std::memory_order_acquire); slot; slot = slot->nextReleased) {
+                bucketFor(slot->releaseTimeline).push_back(slot);
+                queued++;
+            }
+
+            // buckets are ordered by timeline so only the ready ones at the front are touched
+            const auto timelineValue = _getTimelineValue();
+            while (_bucketCount > 0) {
+                auto &bucket = _destroyBuckets[_bucketHead];
+                if ((bucket.timeline + _destructionDelay) >= timelineValue)
+                    break;
+                for (auto *slot : bucket.slots) {
+                    func(slot->resource);
+                    freeSlot(*slot);
+                    pushFree(slot);
+                }
+                destroyed += bucket.slots.size();
+                bucket.slots.clear();
+                _bucketHead = (_bucketHead + 1) % _destroyBuckets.size();
+                _bucketCount--;
             }
+            _toDestroy.fetch_sub(destroyed, std::memory_order_relaxed);
+            _queued = queued;
+            _destroyed = destroyed;
         }
+        if (const auto logger = _logger.lock(); logger && destroyed > 0)
+            logger->debug("{} GPU Resource {} destroyed", destroyed, typeid(T).name());
     }
 
     void clearAll(std::function<void(T &)> func = [](auto &resource) { resource = {}; }) {
         std::unique_lock lock(_mutex);
-        for (auto &resource : _resources) {
-            resource->second->deleter = {};
-            func(resource->first);
+        _released.store(nullptr);
+        for (auto &bucket : _destroyBuckets)
+            bucket.slots.clear();
+        _bucketHead = 0;
+        _bucketCount = 0;
+        _toDestroy.store(0);
+        _freeHead.store(0);
+        _freeCount.store(0);
+        for (auto *slot : _slots) {
+            func(slot->resource);
+            freeSlot(*slot);
         }
-        _resources.clear();
-        _destroyQueue.clear();
-        _freeResources.clear();
+        // chunks are kept so handles still held to cleared resources can see their slot has moved on
+        for (auto it = _slots.rbegin(); it != _slots.rend(); ++it)
+            pushFree(*it);
     }
 
     // destroys the resources but not the handle itself
     // use for cyclic dependencies
     void destroyAll(std::function<void(T &)> func = [](auto &resource) { resource = {}; }) {
         std::unique_lock lock(_mutex);
-        for (auto &resource : _resources) {
-            func(resource->first);
+        for (auto *slot : _slots) {
+            func(slot->resource);
         }
     }
 
     [[nodiscard]] auto getHandle(i32 index) -> ResourceHandle {
-        if (index >= _resources.size())
+        std::unique_lock lock(_mutex);
+        if (index < 0 || index >= _slots.size())
+            return {};
+        ++_slots[index]->count;
+        return ResourceHandle::create(this, _slots[index]);
+    }
+
+    [[nodiscard]] auto getRef(i32 index) -> ResourceRef {
+        std::unique_lock lock(_mutex);
+        if (index < 0 || index >= _slots.size())
             return {};
-        ++_resources[index]->second->count;
-        return ResourceHandle::create(this, _resources[index]->second);
+        ResourceRef ref = {};
+        ref._slot = _slots[index];
+        ref._generation = ref._slot->generation.load(std::memory_order_relaxed);
+        return ref;
     }
 
-    auto allocated() const -> u32 { return _resources.size(); }
+    // slots reserved by the chunks so far
+    auto allocated() const -> u32 { return _slots.size(); }
 
-    auto toDestroy() const -> u32 { return _destroyQueue.size(); }
+    auto toDestroy() const -> u32 { return _toDestroy.load(std::memory_order_relaxed); }
 
-    auto free() const -> u32 { return _freeResources.size(); }
+    // released and destroyed by the last clearQueue, once per frame when called from Device::gc
+    auto queued() const -> u32 { return _queued; }
+    auto destroyed() const -> u32 { return _destroyed; }
+
+    auto free() const -> u32 { return _freeCount.load(std::memory_order_relaxed); }
 
     auto used() const -> u32 { return allocated() - free(); }
 
   private:
     friend Handle<T, ResourceList>;
+    friend Ref<T, ResourceList>;
+
+    // called by the last handle of a slot, pushed onto a lock free stack that clearQueue takes whole
+    void destroy(Slot *slot) {
+        slot->releaseTimeline = _getTimelineValue();
+        _toDestroy.fetch_add(1, std::memory_order_relaxed);
+        auto *head = _released.load(std::memory_order_relaxed);
+        do {
+            slot->nextReleased = head;
+        } while (!_released.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // resets the slot to a fresh resource ready to be taken again
+    static void freeSlot(Slot &slot) {
+        std::destroy_at(&slot.resource);
+        std::construct_at(&slot.resource);
+        slot.count = 0;
+        slot.generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // buckets stay sorted by timeline, a new one is added at the back and moved forward past any later ones
+    auto bucketFor(const u64 timeline) -> std::vector<Slot *> & {
+        const auto bucketAt = [this](const u32 i) -> DestroyBucket & {
+            return _destroyBuckets[(_bucketHead + i) % _destroyBuckets.size()];
+        };
+        for (u32 i = _bucketCount; i-- > 0;) {
+            if (bucketAt(i).timeline == timeline)
+                return bucketAt(i).slots;
+            if (bucketAt(i).timeline < timeline)
+                break;
+        }
+        if (_bucketCount == _destroyBuckets.size()) {
+            std::rotate(_destroyBuckets.begin(), _destroyBuckets.begin() + _bucketHead, _destroyBuckets.end());
+            _destroyBuckets.resize(std::max<u32>(4, _destroyBuckets.size() * 2));
+            _bucketHead = 0;
+        }
+        u32 i = _bucketCount++;
+        bucketAt(i).timeline = timeline;
+        for (; i > 0 && bucketAt(i - 1).timeline > timeline; i--)
+            std::swap(bucketAt(i), bucketAt(i - 1));
+        return bucketAt(i).slots;
+    }
+
+    auto slotAt(const u32 position) const -> Slot * {
+        const u32 chunk = std::bit_width(position / CHUNK_SIZE + 1) - 1;
+        const u32 offset = position - CHUNK_SIZE * ((1u << chunk) - 1);
+        return &_chunks[chunk].load(std::memory_order_acquire)[offset];
+    }
+
+    // the head packs a tag above the position so a slot popped and pushed back between a load and the
+    // compare exchange can't be mistaken for an unchanged list
+    static constexpr u64 POSITION_MASK = 0xffffffff;
+    static constexpr u64 TAG = POSITION_MASK + 1;
+
+    auto popFree() -> Slot * {
+        u64 head = _freeHead.load(std::memory_order_acquire);
+        while (head & POSITION_MASK) {
+            auto *slot = slotAt((head & POSITION_MASK) - 1);
+            const u64 next = ((head & ~POSITION_MASK) + TAG) | slot->nextFree.load(std::memory_order_relaxed);
+            if (_freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+                _freeCount.fetch_sub(1, std::memory_order_relaxed);
+                return slot;
+            }
+        }
+        return nullptr;
+    }
+
+    void pushFree(Slot *slot) {
+        u64 head = _freeHead.load(std::memory_order_relaxed);
+        u64 next = 0;
+        do {
+            slot->nextFree.store(head & POSITION_MASK, std::memory_order_relaxed);
+            next = ((head & ~POSITION_MASK) + TAG) | (slot->position + 1);
+        } while (!_freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+        _freeCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    std::vector<std::unique_ptr<std::pair<T, std::shared_ptr<ResourceData>>>> _resources = {};
-    std::vector<u32> _freeResources = {};
-    std::vector<std::pair<u64, i32>> _destroyQueue = {};
+    // adds the next chunk, keeps its first slot and frees the rest
+    auto grow() -> Slot * {
+        std::unique_lock lock(_mutex);
+        // another thread may have grown the list while this one waited
+        if (auto *slot = popFree())
+            return slot;
+
+        const u32 chunk = _chunkCount++;
+        assert(chunk < MAX_CHUNKS);
+        const u32 size = CHUNK_SIZE << chunk;
+        const u32 first = _slots.size();
+        auto *slots = new Slot[size]();
+        for (u32 i = 0; i < size; i++) {
+            slots[i].position = first + i;
+            slots[i].index = first + i;
+            _slots.push_back(&slots[i]);
+        }
+        _chunks[chunk].store(slots, std::memory_order_release);
+        for (u32 i = size - 1; i > 0; i--)
+            pushFree(&slots[i]);
+        return &slots[0];
+    }
+
+    void exchange(ResourceList &rhs) noexcept {
+        for (u32 i = 0; i < MAX_CHUNKS; i++)
+            _chunks[i] = rhs._chunks[i].exchange(_chunks[i]);
+        std::swap(_chunkCount, rhs._chunkCount);
+        std::swap(_slots, rhs._slots);
+        _freeHead = rhs._freeHead.exchange(_freeHead);
+        _freeCount = rhs._freeCount.exchange(_freeCount);
+        _released = rhs._released.exchange(_released);
+        _toDestroy = rhs._toDestroy.exchange(_toDestroy);
+        std::swap(_destroyBuckets, rhs._destroyBuckets);
+        std::swap(_bucketHead, rhs._bucketHead);
+        std::swap(_bucketCount, rhs._bucketCount);
+        std::swap(_queued, rhs._queued);
+        std::swap(_destroyed, rhs._destroyed);
+        std::swap(_destructionDelay, rhs._destructionDelay);
+        std::swap(_getTimelineValue, rhs._getTimelineValue);
+        std::swap(_logger, rhs._logger);
+    }
+
+    std::array<std::atomic<Slot *>, MAX_CHUNKS> _chunks = {};
+    u32 _chunkCount = 0;
+    // index to slot, swap and reallocate move slots between indices
+    std::vector<Slot *> _slots = {};
+    std::atomic<u64> _freeHead = 0;
+    std::atomic<u32> _freeCount = 0;
+    std::atomic<Slot *> _released = nullptr;
+    struct DestroyBucket {
+        u64 timeline = 0;
+        std::vector<Slot *> slots = {};
+    };
+    // ring of buckets in timeline order, the vectors keep their capacity between frames
+    std::vector<DestroyBucket> _destroyBuckets = {};
+    u32 _bucketHead = 0;
+    u32 _bucketCount = 0;
+    u32 _queued = 0;
+    u32 _destroyed = 0;
+    std::atomic<u32> _toDestroy = 0;
     u32 _destructionDelay = 3;
     std::function<u64()> _getTimelineValue = [] { return 0; };
     std::mutex _mutex = {};
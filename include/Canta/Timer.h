@@ -22,6 +22,14 @@ class Timer {
     void end(CommandBuffer &commandBuffer, PipelineStage stage = PipelineStage::BOTTOM);
 
     [[nodiscard]] auto result() -> std::expected<u64, VulkanError>;
+    // device timestamp of begin() in nanoseconds, valid once result() has returned a value
+    [[nodiscard]] auto start() const -> u64 { return _start; }
+
+    // drop the cached result when begin() runs from a replayed command buffer instead of being called again
+    void reset() {
+        _value = 0;
+        _start = 0;
+    }
 
   private:
     friend Device;
@@ -30,6 +38,7 @@ class Timer {
     u32 _queryPoolIndex = 0;
     u32 _index = 0;
     u64 _value = 0;
+    u64 _start = 0;
 };
 
 } // namespace canta
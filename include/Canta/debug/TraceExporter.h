@@ -0,0 +1,52 @@
+#ifndef CANTA_TRACEEXPORTER_H
+#define CANTA_TRACEEXPORTER_H
+
+#include <Canta/RenderGraph.h>
+#include <deque>
+#include <filesystem>
+
+namespace canta {
+
+// collects the cpu and gpu timings of a render graph over several frames and writes them as chrome trace event json,
+// viewable in chrome://tracing or perfetto
+class TraceExporter {
+  public:
+    struct CreateInfo {
+        RenderGraph *renderGraph;
+        // older frames are dropped past this, 0 keeps everything captured
+        u32 maxFrames = 0;
+    };
+    static auto create(const CreateInfo &info) -> TraceExporter;
+
+    // call once per frame after Device::beginFrame() so the gpu timers being read have completed. cpu timings need
+    // RenderGraph::setCpuProfiling and gpu timings RenderGraph::setTimingMode
+    void capture();
+
+    [[nodiscard]] auto json() const -> std::string;
+    auto write(const std::filesystem::path &path) const -> bool;
+
+    void clear() { _frames.clear(); }
+    [[nodiscard]] auto frameCount() const -> u32 { return _frames.size(); }
+
+    void setRenderGraph(RenderGraph *renderGraph) { _renderGraph = renderGraph; }
+
+  private:
+    struct Event {
+        std::string name = {};
+        std::string_view category = {};
+        // host steady clock nanoseconds, gpu timestamps are moved onto it when the device can calibrate them
+        u64 start = 0;
+        u64 duration = 0;
+        u32 process = 0;
+        u32 thread = 0;
+    };
+
+    RenderGraph *_renderGraph = nullptr;
+    u32 _maxFrames = 0;
+    u32 _cpuFrame = 0;
+    std::deque<std::vector<Event>> _frames = {};
+};
+
+} // namespace canta
+
+#endif // CANTA_TRACEEXPORTER_H
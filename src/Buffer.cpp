@@ -22,6 +22,7 @@ canta::Buffer::Buffer(canta::Buffer &&rhs) noexcept {
     rhs._mapped._buffer = &rhs;
     std::swap(_requiredFlags, rhs._requiredFlags);
     std::swap(_preferredFlags, rhs._preferredFlags);
+    std::swap(_aliased, rhs._aliased);
     std::swap(_name, rhs._name);
 }
 
@@ -38,6 +39,7 @@ auto canta::Buffer::operator=(canta::Buffer &&rhs) noexcept -> Buffer & {
     rhs._mapped._buffer = &rhs;
     std::swap(_requiredFlags, rhs._requiredFlags);
     std::swap(_preferredFlags, rhs._preferredFlags);
+    std::swap(_aliased, rhs._aliased);
     std::swap(_name, rhs._name);
     return *this;
 }
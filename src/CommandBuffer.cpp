@@ -18,14 +18,14 @@ auto canta::CommandBuffer::operator=(canta::CommandBuffer &&rhs) noexcept -> Com
     return *this;
 }
 
-auto canta::CommandBuffer::begin() -> bool {
+auto canta::CommandBuffer::begin(const bool oneTimeSubmit) -> bool {
     _stats = {};
     if (_active)
         return false;
     _active = true;
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.flags = oneTimeSubmit ? VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT : 0;
     return vkBeginCommandBuffer(_buffer, &beginInfo) == VK_SUCCESS;
 }
 
@@ -455,7 +455,7 @@ void canta::CommandBuffer::generateMips(canta::ImageHandle image, ImageLayout in
     });
 }
 
-void canta::CommandBuffer::barrier(ImageBarrier barrier) {
+auto toVkBarrier(const canta::ImageBarrier &barrier) -> VkImageMemoryBarrier2 {
     VkImageMemoryBarrier2 imageBarrier = {};
     imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
     imageBarrier.image = barrier.image->image();
@@ -473,16 +473,10 @@ void canta::CommandBuffer::barrier(ImageBarrier barrier) {
     imageBarrier.subresourceRange.levelCount = barrier.mipCount == 0 ? VK_REMAINING_MIP_LEVELS : barrier.mipCount;
     imageBarrier.subresourceRange.baseMipLevel = barrier.mip;
     imageBarrier.subresourceRange.aspectMask = aspectMask(barrier.image->format());
-
-    VkDependencyInfo info = {};
-    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
-    info.imageMemoryBarrierCount = 1;
-    info.pImageMemoryBarriers = &imageBarrier;
-    vkCmdPipelineBarrier2(_buffer, &info);
-    _stats.barriers++;
+    return imageBarrier;
 }
 
-void canta::CommandBuffer::barrier(canta::BufferBarrier barrier) {
+auto toVkBarrier(const canta::BufferBarrier &barrier) -> VkBufferMemoryBarrier2 {
     VkBufferMemoryBarrier2 bufferBarrier = {};
     bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
     bufferBarrier.buffer = barrier.buffer->buffer();
@@ -494,6 +488,32 @@ void canta::CommandBuffer::barrier(canta::BufferBarrier barrier) {
     bufferBarrier.dstQueueFamilyIndex = barrier.dstQueue;
     bufferBarrier.offset = barrier.offset;
     bufferBarrier.size = barrier.size == 0 ? VK_WHOLE_SIZE : barrier.size;
+    return bufferBarrier;
+}
+
+auto toVkBarrier(const canta::MemoryBarrier &barrier) -> VkMemoryBarrier2 {
+    VkMemoryBarrier2 memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    memoryBarrier.srcStageMask = static_cast<VkPipelineStageFlagBits>(barrier.srcStage);
+    memoryBarrier.dstStageMask = static_cast<VkPipelineStageFlagBits>(barrier.dstStage);
+    memoryBarrier.srcAccessMask = static_cast<VkAccessFlagBits>(barrier.srcAccess);
+    memoryBarrier.dstAccessMask = static_cast<VkAccessFlagBits>(barrier.dstAccess);
+    return memoryBarrier;
+}
+
+void canta::CommandBuffer::barrier(ImageBarrier barrier) {
+    const auto imageBarrier = toVkBarrier(barrier);
+
+    VkDependencyInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    info.imageMemoryBarrierCount = 1;
+    info.pImageMemoryBarriers = &imageBarrier;
+    vkCmdPipelineBarrier2(_buffer, &info);
+    _stats.barriers++;
+}
+
+void canta::CommandBuffer::barrier(canta::BufferBarrier barrier) {
+    const auto bufferBarrier = toVkBarrier(barrier);
 
     VkDependencyInfo info = {};
     info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
@@ -504,12 +524,7 @@ void canta::CommandBuffer::barrier(canta::BufferBarrier barrier) {
 }
 
 void canta::CommandBuffer::barrier(canta::MemoryBarrier barrier) {
-    VkMemoryBarrier2 memoryBarrier = {};
-    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
-    memoryBarrier.srcStageMask = static_cast<VkPipelineStageFlagBits>(barrier.srcStage);
-    memoryBarrier.dstStageMask = static_cast<VkPipelineStageFlagBits>(barrier.dstStage);
-    memoryBarrier.srcAccessMask = static_cast<VkAccessFlagBits>(barrier.srcAccess);
-    memoryBarrier.dstAccessMask = static_cast<VkAccessFlagBits>(barrier.dstAccess);
+    const auto memoryBarrier = toVkBarrier(barrier);
 
     VkDependencyInfo info = {};
     info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
@@ -519,6 +534,56 @@ void canta::CommandBuffer::barrier(canta::MemoryBarrier barrier) {
     _stats.barriers++;
 }
 
+template <typename F>
+void withDependencyInfo(std::span<const canta::ImageBarrier> imageBarriers, std::span<const canta::BufferBarrier> bufferBarriers, std::span<const canta::MemoryBarrier> memoryBarriers, F &&func) {
+    VkImageMemoryBarrier2 vkImageBarriers[imageBarriers.size()];
+    for (u32 i = 0; i < imageBarriers.size(); i++)
+        vkImageBarriers[i] = toVkBarrier(imageBarriers[i]);
+    VkBufferMemoryBarrier2 vkBufferBarriers[bufferBarriers.size()];
+    for (u32 i = 0; i < bufferBarriers.size(); i++)
+        vkBufferBarriers[i] = toVkBarrier(bufferBarriers[i]);
+    VkMemoryBarrier2 vkMemoryBarriers[memoryBarriers.size()];
+    for (u32 i = 0; i < memoryBarriers.size(); i++)
+        vkMemoryBarriers[i] = toVkBarrier(memoryBarriers[i]);
+
+    VkDependencyInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    info.imageMemoryBarrierCount = imageBarriers.size();
+    info.pImageMemoryBarriers = vkImageBarriers;
+    info.bufferMemoryBarrierCount = bufferBarriers.size();
+    info.pBufferMemoryBarriers = vkBufferBarriers;
+    info.memoryBarrierCount = memoryBarriers.size();
+    info.pMemoryBarriers = vkMemoryBarriers;
+    func(info);
+}
+
+void canta::CommandBuffer::barriers(std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers, std::span<const MemoryBarrier> memoryBarriers) {
+    if (imageBarriers.empty() && bufferBarriers.empty() && memoryBarriers.empty())
+        return;
+
+    withDependencyInfo(imageBarriers, bufferBarriers, memoryBarriers, [this](const VkDependencyInfo &info) {
+        vkCmdPipelineBarrier2(_buffer, &info);
+    });
+    _stats.barriers++;
+}
+
+void canta::CommandBuffer::setEvent(VkEvent event, std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers, std::span<const MemoryBarrier> memoryBarriers) {
+    withDependencyInfo(imageBarriers, bufferBarriers, memoryBarriers, [this, event](const VkDependencyInfo &info) {
+        vkCmdSetEvent2(_buffer, event, &info);
+    });
+}
+
+void canta::CommandBuffer::waitEvent(VkEvent event, std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers, std::span<const MemoryBarrier> memoryBarriers) {
+    withDependencyInfo(imageBarriers, bufferBarriers, memoryBarriers, [this, event](const VkDependencyInfo &info) {
+        vkCmdWaitEvents2(_buffer, 1, &event, &info);
+    });
+    _stats.barriers++;
+}
+
+void canta::CommandBuffer::resetEvent(VkEvent event, PipelineStage stage) {
+    vkCmdResetEvent2(_buffer, event, static_cast<VkPipelineStageFlags2>(stage));
+}
+
 void canta::CommandBuffer::pushDebugLabel(std::string_view label, std::array<f32, 4> colour) {
 #ifndef NDEBUG
     VkDebugUtilsLabelEXT labelInfo = {};
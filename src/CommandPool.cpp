@@ -2,7 +2,7 @@
 #include <Canta/Device.h>
 
 template <>
-u32 canta::CommandHandle ::s_hash = 0;
+std::atomic<u32> canta::CommandHandle ::s_hash = 0;
 
 canta::CommandPool::~CommandPool() {
     if (!_device)
@@ -16,17 +16,17 @@
 #include "embedded_shaders_Canta.h"
 
 template <>
-u32 canta::PipelineHandle::s_hash = 0;
+std::atomic<u32> canta::PipelineHandle::s_hash = 0;
 template <>
-u32 canta::ImageHandle::s_hash = 0;
+std::atomic<u32> canta::ImageHandle::s_hash = 0;
 template <>
-u32 canta::ImageViewHandle::s_hash = 0;
+std::atomic<u32> canta::ImageViewHandle::s_hash = 0;
 template <>
-u32 canta::BufferHandle::s_hash = 0;
+std::atomic<u32> canta::BufferHandle::s_hash = 0;
 template <>
-u32 canta::SamplerHandle::s_hash = 0;
+std::atomic<u32> canta::SamplerHandle::s_hash = 0;
 template <>
-u32 canta::SemaphoreHandle ::s_hash = 0;
+std::atomic<u32> canta::SemaphoreHandle ::s_hash = 0;
 
 template <typename T, typename U>
 void appendFeatureChain(T *start, U *next) {
@@ -383,6 +383,7 @@ auto canta::Device::create(CreateInfo info) noexcept -> std::expected<std::uniqu
 #ifndef NDEBUG
     ENABLE_EXTENSION(VK_AMD_BUFFER_MARKER_EXTENSION_NAME, deviceExtensions);
 #endif
+    ENABLE_EXTENSION(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME, deviceExtensions);
 
     VkPhysicalDeviceFeatures2 deviceFeatures2 = {};
     deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
@@ -454,6 +455,9 @@ auto canta::Device::create(CreateInfo info) noexcept -> std::expected<std::uniqu
     device->_enabledExtensions.insert(device->_enabledExtensions.begin(), instanceExtensions.begin(), instanceExtensions.end());
 
     volkLoadDevice(device->_logicalDevice);
+    device->_calibratedTimestamps = std::ranges::find_if(deviceExtensions, [](const char *extension) {
+        return std::string_view(extension) == VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+    }) != deviceExtensions.end();
 
     device->logger().info("Logical device creation successful");
 
@@ -769,11 +773,13 @@ void canta::Device::gc() {
     _pipelineList.clearQueue();
     _imageViewList.clearQueue();
     _imageList.clearQueue([this](auto &resource) {
-        _memoryUsage -= (resource.width() * resource.height() * resource.depth() * formatSize(resource.format()));
+        if (!resource.aliased())
+            _memoryUsage -= (resource.width() * resource.height() * resource.depth() * formatSize(resource.format()));
         resource = {};
     });
     _bufferList.clearQueue([this](auto &resource) {
-        _memoryUsage -= resource.size();
+        if (!resource.aliased())
+            _memoryUsage -= resource.size();
         resource = {};
     });
     _samplerList.clearQueue();
@@ -886,6 +892,26 @@ auto canta::Device::createSemaphore(Semaphore::CreateInfo info) -> std::expected
     return handle;
 }
 
+auto canta::Device::waitSemaphores(std::span<const SemaphorePair> semaphores, const bool waitAll, const u64 timeout) const -> std::expected<bool, VulkanError> {
+    VkSemaphore handles[semaphores.size()];
+    u64 values[semaphores.size()];
+    for (u32 i = 0; i < semaphores.size(); i++) {
+        handles[i] = semaphores[i].semaphore->semaphore();
+        values[i] = semaphores[i].value;
+    }
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.flags = waitAll ? 0 : VK_SEMAPHORE_WAIT_ANY_BIT;
+    waitInfo.semaphoreCount = semaphores.size();
+    waitInfo.pSemaphores = handles;
+    waitInfo.pValues = values;
+    auto result = vkWaitSemaphores(logicalDevice(), &waitInfo, timeout);
+    if (result != VK_SUCCESS && result != VK_TIMEOUT)
+        return std::unexpected(static_cast<VulkanError>(result));
+    return result == VK_SUCCESS;
+}
+
 auto canta::Device::createCommandPool(CommandPool::CreateInfo info) -> std::expected<CommandPool, VulkanError> {
     CommandPool pool = {};
     pool._device = this;
@@ -929,6 +955,16 @@ auto canta::Device::createCommandPool(CommandPool::CreateInfo info) -> std::expe
     return pool;
 }
 
+auto canta::Device::createEventPool(EventPool::CreateInfo info) -> std::expected<EventPool, VulkanError> {
+    EventPool pool = {};
+    pool._device = this;
+    pool._name = info.name;
+
+    logger().info("Event pool created");
+
+    return pool;
+}
+
 auto canta::Device::createPipeline(Pipeline::CreateInfo info, const PipelineHandle &oldHandle) -> PipelineHandle {
     ShaderInterface interface = {};
     std::vector<VkPipelineShaderStageCreateInfo> shaderStages = {};
@@ -1360,7 +1396,7 @@ auto canta::Device::createImage(Image::CreateInfo info, ImageHandle oldHandle) -
         info.name = oldHandle->name();
     }
     VkImage image;
-    VmaAllocation allocation;
+    VmaAllocation allocation = VK_NULL_HANDLE;
     VkImageCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 
@@ -1398,16 +1434,20 @@ auto canta::Device::createImage(Image::CreateInfo info, ImageHandle oldHandle) -
     if (info.layers == 6)
         createInfo.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
 
-    VmaAllocationCreateInfo allocInfo = {};
-    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    allocInfo.flags = 0;
-    VK_TRY(vmaCreateImage(_allocator, &createInfo, &allocInfo, &image, &allocation, nullptr))
+    if (info.aliasAllocation) {
+        VK_TRY(vmaCreateAliasingImage2(_allocator, info.aliasAllocation, info.aliasOffset, &createInfo, &image))
+    } else {
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = 0;
+        VK_TRY(vmaCreateImage(_allocator, &createInfo, &allocInfo, &image, &allocation, nullptr))
+
+        _memoryUsage += (info.width * info.height * info.depth * formatSize(info.format));
+    }
 
     if (!info.name.empty())
         setDebugName(VK_OBJECT_TYPE_IMAGE, (u64)image, info.name);
 
-    _memoryUsage += (info.width * info.height * info.depth * formatSize(info.format));
-
     ImageHandle handle = {};
     if (oldHandle)
         handle = _imageList.reallocate(oldHandle);
@@ -1426,6 +1466,7 @@ auto canta::Device::createImage(Image::CreateInfo info, ImageHandle oldHandle) -
     handle->_format = info.format;
     handle->_usage = info.usage;
     handle->_layout = ImageLayout::UNDEFINED;
+    handle->_aliased = info.aliasAllocation != VK_NULL_HANDLE;
     handle->_name = info.name;
     handle->_views.push_back(createImageView({.image = &*handle}));
 
@@ -1567,7 +1608,7 @@ auto canta::Device::createBuffer(Buffer::CreateInfo info, BufferHandle oldHandle
     info.usage |= BufferUsage::TRANSFER_DST | BufferUsage::TRANSFER_SRC | BufferUsage::STORAGE | BufferUsage::DEVICE_ADDRESS;
 
     VkBuffer buffer;
-    VmaAllocation allocation;
+    VmaAllocation allocation = VK_NULL_HANDLE;
     VkBufferCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 
@@ -1594,9 +1635,15 @@ auto canta::Device::createBuffer(Buffer::CreateInfo info, BufferHandle oldHandle
         break;
     }
 
-    VK_TRY(vmaCreateBuffer(_allocator, &createInfo, &allocInfo, &buffer, &allocation, nullptr));
+    if (info.aliasAllocation) {
+        // aliased memory is only ever device local so cant be mapped
+        info.persistentlyMapped = false;
+        VK_TRY(vmaCreateAliasingBuffer2(_allocator, info.aliasAllocation, info.aliasOffset, &createInfo, &buffer));
+    } else {
+        VK_TRY(vmaCreateBuffer(_allocator, &createInfo, &allocInfo, &buffer, &allocation, nullptr));
 
-    _memoryUsage += info.size;
+        _memoryUsage += info.size;
+    }
 
     if (!info.name.empty())
         setDebugName(VK_OBJECT_TYPE_BUFFER, (u64)buffer, info.name);
@@ -1621,6 +1668,7 @@ auto canta::Device::createBuffer(Buffer::CreateInfo info, BufferHandle oldHandle
     handle->_type = info.type;
     handle->_requiredFlags = info.requiredFlags;
     handle->_preferredFlags = info.preferredFlags;
+    handle->_aliased = info.aliasAllocation != VK_NULL_HANDLE;
     handle->_name = info.name;
 
     if (info.persistentlyMapped)
@@ -1683,6 +1731,94 @@ auto canta::Device::resizeBuffer(canta::BufferHandle handle, u32 newSize) -> Buf
                         handle);
 }
 
+auto canta::Device::memoryRequirements(Buffer::CreateInfo info) const -> VkMemoryRequirements {
+    info.usage |= BufferUsage::TRANSFER_DST | BufferUsage::TRANSFER_SRC | BufferUsage::STORAGE | BufferUsage::DEVICE_ADDRESS;
+
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = info.size;
+    createInfo.usage = static_cast<VkBufferUsageFlagBits>(info.usage);
+    createInfo.sharingMode = _enabledQueueFamilies.size() == 1 ? VK_SHARING_MODE_EXCLUSIVE : VK_SHARING_MODE_CONCURRENT;
+    createInfo.queueFamilyIndexCount = _enabledQueueFamilies.size();
+    createInfo.pQueueFamilyIndices = _enabledQueueFamilies.data();
+
+    VkDeviceBufferMemoryRequirements requirementsInfo = {};
+    requirementsInfo.sType = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS;
+    requirementsInfo.pCreateInfo = &createInfo;
+
+    VkMemoryRequirements2 requirements = {};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    vkGetDeviceBufferMemoryRequirements(logicalDevice(), &requirementsInfo, &requirements);
+    return requirements.memoryRequirements;
+}
+
+auto canta::Device::memoryRequirements(Image::CreateInfo info) const -> VkMemoryRequirements {
+    VkImageCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+
+    if (info.type == ImageType::AUTO) {
+        if (info.depth > 1)
+            createInfo.imageType = VK_IMAGE_TYPE_3D;
+        else if (info.height > 1)
+            createInfo.imageType = VK_IMAGE_TYPE_2D;
+        else
+            createInfo.imageType = VK_IMAGE_TYPE_1D;
+    } else {
+        createInfo.imageType = static_cast<VkImageType>(info.type);
+    }
+
+    createInfo.format = static_cast<VkFormat>(info.format);
+    createInfo.extent.width = info.width;
+    createInfo.extent.height = info.height;
+    createInfo.extent.depth = info.depth;
+    createInfo.mipLevels = info.mipLevels;
+    createInfo.arrayLayers = info.layers;
+
+    createInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    createInfo.usage = static_cast<VkImageUsageFlagBits>(info.usage);
+    createInfo.sharingMode = _enabledQueueFamilies.size() == 1 ? VK_SHARING_MODE_EXCLUSIVE : VK_SHARING_MODE_CONCURRENT;
+    createInfo.queueFamilyIndexCount = _enabledQueueFamilies.size();
+    createInfo.pQueueFamilyIndices = _enabledQueueFamilies.data();
+    createInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+    if (info.layers == 6)
+        createInfo.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+
+    VkDeviceImageMemoryRequirements requirementsInfo = {};
+    requirementsInfo.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+    requirementsInfo.pCreateInfo = &createInfo;
+
+    VkMemoryRequirements2 requirements = {};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    vkGetDeviceImageMemoryRequirements(logicalDevice(), &requirementsInfo, &requirements);
+    return requirements.memoryRequirements;
+}
+
+auto canta::Device::allocateMemory(const VkMemoryRequirements &requirements) -> std::expected<VmaAllocation, VulkanError> {
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    VmaAllocation allocation = VK_NULL_HANDLE;
+    if (const auto result = vmaAllocateMemory(_allocator, &requirements, &allocInfo, &allocation, nullptr); result != VK_SUCCESS)
+        return std::unexpected(static_cast<VulkanError>(result));
+
+    _memoryUsage += requirements.size;
+    logger().info("Allocated {} bytes of memory", requirements.size);
+
+    return allocation;
+}
+
+void canta::Device::freeMemory(VmaAllocation allocation) {
+    if (!allocation)
+        return;
+    VmaAllocationInfo info = {};
+    vmaGetAllocationInfo(_allocator, allocation, &info);
+    _memoryUsage -= info.size;
+    vmaFreeMemory(_allocator, allocation);
+}
+
 auto canta::Device::swapImageBindings(canta::ImageHandle oldHandle, canta::ImageHandle newHandle) -> ImageHandle {
     _imageViewList.swap(oldHandle->defaultView(), newHandle->defaultView());
 
@@ -1716,7 +1852,6 @@ void canta::Device::updateBindlessImage(u32 index, ImageViewHandle image, bool s
         .imageView = image,
         .sampled = sampled,
         .storage = storage,
-        .endFrame = frameValue() + FRAMES_IN_FLIGHT,
     });
 }
 
@@ -1725,7 +1860,6 @@ void canta::Device::updateBindlessBuffer(u32 index, canta::BufferHandle buffer)
     _descriptorUpdates.push_back({
         .index = index,
         .buffer = buffer,
-        .endFrame = frameValue() + FRAMES_IN_FLIGHT,
     });
 }
 
@@ -1734,96 +1868,101 @@ void canta::Device::updateBindlessSampler(u32 index, canta::SamplerHandle sample
     _descriptorUpdates.push_back({
         .index = index,
         .sampler = sampler,
-        .endFrame = frameValue() + FRAMES_IN_FLIGHT,
     });
 }
 
 void canta::Device::updateBindlessDescriptors() {
     std::unique_lock lock(_descriptorMutex);
+    if (_descriptorUpdates.empty())
+        return;
+
+    const u32 frameIndex = flyingIndex();
+    const u32 setMask = 1u << frameIndex;
+    const auto set = _bindlessSets[frameIndex];
+
+    // reserved up front so the writes can point into the infos as they are added
+    _descriptorWrites.clear();
+    _descriptorImageInfos.clear();
+    _descriptorBufferInfos.clear();
+    _descriptorWrites.reserve(_descriptorUpdates.size() * 2);
+    _descriptorImageInfos.reserve(_descriptorUpdates.size() * 2);
+    _descriptorBufferInfos.reserve(_descriptorUpdates.size());
+
+    const auto write = [&](const u32 index, const VkDescriptorType type, const u32 binding) -> VkWriteDescriptorSet & {
+        auto &descriptorWrite = _descriptorWrites.emplace_back();
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.descriptorType = type;
+        descriptorWrite.dstArrayElement = index;
+        descriptorWrite.dstSet = set;
+        descriptorWrite.dstBinding = binding;
+        return descriptorWrite;
+    };
 
-    auto frameVal = frameValue();
+    for (auto &update : _descriptorUpdates) {
+        // run() flushes again after beginFrame(), skip what this frame's set already has
+        if (update.writtenSets & setMask)
+            continue;
+        update.writtenSets |= setMask;
 
-    for (auto it = _descriptorUpdates.begin(); it != _descriptorUpdates.end(); ++it) {
-        auto &update = *it;
         if (update.imageView) {
-            VkWriteDescriptorSet descriptorWrite[2] = {};
-            i32 writeNum = 0;
-
-            VkDescriptorImageInfo sampledImageInfo = {};
             if (update.sampled) {
-                sampledImageInfo.imageView = update.imageView->view();
-                sampledImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-                descriptorWrite[writeNum].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrite[writeNum].descriptorCount = 1;
-                descriptorWrite[writeNum].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-                descriptorWrite[writeNum].dstArrayElement = update.index;
-                descriptorWrite[writeNum].dstSet = bindlessSet();
-                descriptorWrite[writeNum].dstBinding = CANTA_BINDLESS_SAMPLED_IMAGES;
-                descriptorWrite[writeNum].pImageInfo = &sampledImageInfo;
-                writeNum++;
+                auto &imageInfo = _descriptorImageInfos.emplace_back();
+                imageInfo.imageView = update.imageView->view();
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                write(update.index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, CANTA_BINDLESS_SAMPLED_IMAGES).pImageInfo = &imageInfo;
             }
-            VkDescriptorImageInfo storageImageInfo = {};
             if (update.storage) {
-                storageImageInfo.imageView = update.imageView->view();
-                storageImageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                descriptorWrite[writeNum].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-                descriptorWrite[writeNum].descriptorCount = 1;
-                descriptorWrite[writeNum].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-                descriptorWrite[writeNum].dstArrayElement = update.index;
-                descriptorWrite[writeNum].dstSet = bindlessSet();
-                descriptorWrite[writeNum].dstBinding = CANTA_BINDLESS_STORAGE_IMAGES;
-                descriptorWrite[writeNum].pImageInfo = &storageImageInfo;
-                writeNum++;
+                auto &imageInfo = _descriptorImageInfos.emplace_back();
+                imageInfo.imageView = update.imageView->view();
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                write(update.index, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, CANTA_BINDLESS_STORAGE_IMAGES).pImageInfo = &imageInfo;
             }
-
-            vkUpdateDescriptorSets(logicalDevice(), writeNum, descriptorWrite, 0, nullptr);
-
-            logger().info("FrameIndex({}): Image {} bound to index {}", flyingIndex(), update.imageView->_image->name(), update.index);
         } else if (update.buffer) {
-            VkWriteDescriptorSet descriptorWrite = {};
-
-            VkDescriptorBufferInfo bufferInfo = {};
+            auto &bufferInfo = _descriptorBufferInfos.emplace_back();
             bufferInfo.buffer = update.buffer->buffer();
             bufferInfo.offset = 0;
             bufferInfo.range = update.buffer->size();
-
-            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrite.descriptorCount = 1;
-            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            descriptorWrite.dstArrayElement = update.index;
-            descriptorWrite.dstSet = bindlessSet();
-            descriptorWrite.dstBinding = CANTA_BINDLESS_STORAGE_BUFFERS;
-            descriptorWrite.pBufferInfo = &bufferInfo;
-
-            vkUpdateDescriptorSets(logicalDevice(), 1, &descriptorWrite, 0, nullptr);
-
-            logger().info("FrameIndex({}): Buffer {} bound to index {}", flyingIndex(), update.buffer->name(), update.index);
+            write(update.index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, CANTA_BINDLESS_STORAGE_BUFFERS).pBufferInfo = &bufferInfo;
         } else if (update.sampler) {
-            VkWriteDescriptorSet descriptorWrite = {};
-
-            VkDescriptorImageInfo samplerInfo = {};
+            auto &samplerInfo = _descriptorImageInfos.emplace_back();
             samplerInfo.sampler = update.sampler->sampler();
+            write(update.index, VK_DESCRIPTOR_TYPE_SAMPLER, CANTA_BINDLESS_SAMPLERS).pImageInfo = &samplerInfo;
+        }
+    }
 
-            descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrite.descriptorCount = 1;
-            descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-            descriptorWrite.dstArrayElement = update.index;
-            descriptorWrite.dstSet = bindlessSet();
-            descriptorWrite.dstBinding = CANTA_BINDLESS_SAMPLERS;
-            descriptorWrite.pImageInfo = &samplerInfo;
+    if (!_descriptorWrites.empty()) {
+        vkUpdateDescriptorSets(logicalDevice(), _descriptorWrites.size(), _descriptorWrites.data(), 0, nullptr);
+        logger().debug("FrameIndex({}): {} bindless descriptors written", frameIndex, _descriptorWrites.size());
+    }
 
-            vkUpdateDescriptorSets(logicalDevice(), 1, &descriptorWrite, 0, nullptr);
+    // done once every frame in flight has its own copy. removal keeps the order so a later update to the same index
+    // is still written after an earlier one
+    constexpr u32 allSets = (1u << FRAMES_IN_FLIGHT) - 1;
+    std::erase_if(_descriptorUpdates, [](const auto &update) { return update.writtenSets == allSets; });
+}
 
-            logger().info("FrameIndex({}): Sampler bound to index {}", flyingIndex(), update.index);
-        }
-        // update.frames--;
-        // if (update.frames <= 0) {
-        if (update.endFrame <= frameVal) {
-            _descriptorUpdates.erase(it--);
-        }
-    }
+auto canta::Device::calibrateTimestamps() const -> std::expected<TimestampCalibration, VulkanError> {
+#ifdef __linux__
+    // steady_clock reads CLOCK_MONOTONIC so the host timestamp can be compared with it directly
+    if (!_calibratedTimestamps)
+        return std::unexpected(VulkanError::EXTENSION_NOT_PRESENT);
+    std::array<VkCalibratedTimestampInfoEXT, 2> infos = {};
+    infos[0].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    infos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    infos[1].sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    infos[1].timeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+    std::array<u64, 2> timestamps = {};
+    u64 maxDeviation = 0;
+    if (const auto result = vkGetCalibratedTimestampsEXT(logicalDevice(), infos.size(), infos.data(), timestamps.data(), &maxDeviation); result != VK_SUCCESS)
+        return std::unexpected(static_cast<VulkanError>(result));
+    return TimestampCalibration{
+        .device = static_cast<u64>(static_cast<f64>(timestamps[0]) * limits().timestampPeriod),
+        .host = timestamps[1],
+    };
+#else
+    return std::unexpected(VulkanError::EXTENSION_NOT_PRESENT);
+#endif
 }
 
 auto canta::Device::createTimer() -> Timer {
@@ -1939,7 +2078,9 @@ auto canta::Device::resourceStats() const -> ResourceStats {
         .samplerCount = _samplerList.used(),
         .samplerAllocated = _samplerList.allocated(),
         .timestampQueryPools = static_cast<u32>(_timestampPools.size()),
-        .pipelineStatsPools = static_cast<u32>(_pipelineStatisticsPools.size())};
+        .pipelineStatsPools = static_cast<u32>(_pipelineStatisticsPools.size()),
+        .queuedForDestruction = _pipelineList.queued() + _imageList.queued() + _imageViewList.queued() + _bufferList.queued() + _samplerList.queued(),
+        .destroyed = _pipelineList.destroyed() + _imageList.destroyed() + _imageViewList.destroyed() + _bufferList.destroyed() + _samplerList.destroyed()};
 }
 
 auto canta::Device::memoryUsage() const -> MemoryUsage {
@@ -0,0 +1,45 @@
+#include <Canta/Device.h>
+#include <Canta/EventPool.h>
+#include <format>
+
+canta::EventPool::~EventPool() {
+    if (!_device)
+        return;
+    for (auto &event : _events)
+        vkDestroyEvent(_device->logicalDevice(), event, nullptr);
+}
+
+canta::EventPool::EventPool(EventPool &&rhs) noexcept {
+    std::swap(_device, rhs._device);
+    std::swap(_name, rhs._name);
+    std::swap(_index, rhs._index);
+    std::swap(_events, rhs._events);
+}
+
+auto canta::EventPool::operator=(EventPool &&rhs) noexcept -> EventPool & {
+    std::swap(_device, rhs._device);
+    std::swap(_name, rhs._name);
+    std::swap(_index, rhs._index);
+    std::swap(_events, rhs._events);
+    return *this;
+}
+
+void canta::EventPool::reset() { _index = 0; }
+
+auto canta::EventPool::getEvent() -> VkEvent {
+    if (_index < _events.size())
+        return _events[_index++];
+
+    VkEventCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    createInfo.flags = VK_EVENT_CREATE_DEVICE_ONLY_BIT;
+    VkEvent event = VK_NULL_HANDLE;
+    VK_TRY(vkCreateEvent(_device->logicalDevice(), &createInfo, nullptr, &event));
+
+    if (!_name.empty())
+        _device->setDebugName(VK_OBJECT_TYPE_EVENT, (u64)event, std::format("{}: event {}", _name, _events.size()));
+
+    _events.push_back(event);
+    _index = _events.size();
+    return event;
+}
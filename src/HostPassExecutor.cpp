@@ -0,0 +1,93 @@
+#include <Canta/HostPassExecutor.h>
+
+canta::HostPassExecutor::HostPassExecutor(Device *device, std::shared_ptr<ende::thread::ThreadPool> threadPool)
+    : _device(device),
+      _threadPool(std::move(threadPool)) {
+    _thread = std::thread([this] { run(); });
+}
+
+canta::HostPassExecutor::~HostPassExecutor() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _condition.notify_all();
+    if (_thread.joinable())
+        _thread.join();
+
+    // jobs run in order so signalling in order keeps each timeline increasing
+    for (const auto &job : _pending) {
+        for (const auto &signal : job.signals) {
+            u64 value = 0;
+            vkGetSemaphoreCounterValue(_device->logicalDevice(), signal.semaphore->semaphore(), &value);
+            if (value >= signal.value)
+                continue;
+            if (const auto result = signal.semaphore->signal(signal.value); !result)
+                _device->logger().error("Signal on invalid timeline: {}", static_cast<u32>(result.error()));
+        }
+    }
+}
+
+void canta::HostPassExecutor::enqueue(std::vector<SemaphorePair> waits, std::vector<SemaphorePair> signals, std::function<void()> job) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _pending.push_back({std::move(waits), std::move(signals), std::move(job)});
+    }
+    _condition.notify_one();
+}
+
+auto canta::HostPassExecutor::pending() -> u32 {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _pending.size();
+}
+
+void canta::HostPassExecutor::run() {
+    // short enough that jobs enqueued while waiting are picked up promptly
+    constexpr u64 waitTimeout = 1000000;
+
+    std::vector<PendingJob> jobs = {};
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (jobs.empty())
+                _condition.wait(lock, [this] { return !_pending.empty() || !_running; });
+            if (!_running) {
+                // handed back so the destructor can signal them
+                _pending.insert(_pending.begin(), std::make_move_iterator(jobs.begin()), std::make_move_iterator(jobs.end()));
+                return;
+            }
+            std::move(_pending.begin(), _pending.end(), std::back_inserter(jobs));
+            _pending.clear();
+        }
+
+        // drop satisfied waits and dispatch jobs with none left. remaining jobs contribute their first unsatisfied wait
+        std::vector<SemaphorePair> blocking = {};
+        for (auto it = jobs.begin(); it != jobs.end();) {
+            std::erase_if(it->waits, [this](const SemaphorePair &wait) {
+                u64 value = 0;
+                vkGetSemaphoreCounterValue(_device->logicalDevice(), wait.semaphore->semaphore(), &value);
+                return value >= wait.value;
+            });
+            if (it->waits.empty()) {
+                _threadPool->addJob(std::move(it->job));
+                it = jobs.erase(it);
+                continue;
+            }
+
+            const auto &wait = it->waits.front();
+            auto existing = std::ranges::find_if(blocking, [&](const SemaphorePair &pair) {
+                return pair.semaphore->semaphore() == wait.semaphore->semaphore();
+            });
+            if (existing == blocking.end())
+                blocking.push_back(wait);
+            else
+                existing->value = std::min(existing->value, wait.value);
+            ++it;
+        }
+
+        if (!blocking.empty()) {
+            if (const auto result = _device->waitSemaphores(blocking, false, waitTimeout); !result)
+                _device->logger().error("Host pass wait failed: {}", static_cast<u32>(result.error()));
+        }
+    }
+}
@@ -2,7 +2,14 @@
 #include <Canta/Image.h>
 
 canta::Image::~Image() {
-    if (!_device || !_allocation)
+    if (!_device)
+        return;
+    // aliased images dont own their memory
+    if (_aliased) {
+        vkDestroyImage(_device->logicalDevice(), _image, nullptr);
+        return;
+    }
+    if (!_allocation)
         return;
     vmaDestroyImage(_device->allocator(), _image, _allocation);
 }
@@ -20,6 +27,7 @@ canta::Image::Image(canta::Image &&rhs) noexcept {
     std::swap(_format, rhs._format);
     std::swap(_usage, rhs._usage);
     std::swap(_layout, rhs._layout);
+    std::swap(_aliased, rhs._aliased);
     std::swap(_name, rhs._name);
     std::swap(_views, rhs._views);
 }
@@ -37,6 +45,7 @@ auto canta::Image::operator=(canta::Image &&rhs) noexcept -> Image & {
     std::swap(_format, rhs._format);
     std::swap(_usage, rhs._usage);
     std::swap(_layout, rhs._layout);
+    std::swap(_aliased, rhs._aliased);
     std::swap(_name, rhs._name);
     std::swap(_views, rhs._views);
     return *this;
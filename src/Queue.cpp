@@ -2,62 +2,84 @@
 #include <Canta/Device.h>
 
 auto canta::Queue::submit(std::span<CommandHandle> commandBuffers, std::span<SemaphorePair> waits, std::span<SemaphorePair> signals, VkFence fence) -> std::expected<bool, VulkanError> {
-    VkSemaphoreSubmitInfo waitInfos[waits.size()];
-    VkSemaphoreSubmitInfo signalInfos[signals.size() + 1];
-
-    for (u32 i = 0; i < waits.size(); i++) {
-        auto &wait = waits[i];
-        waitInfos[i].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        waitInfos[i].semaphore = wait.semaphore->semaphore();
-        waitInfos[i].value = wait.value;
-        waitInfos[i].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        waitInfos[i].deviceIndex = 0;
-        waitInfos[i].pNext = nullptr;
-    }
+    const Submission submission = {
+        .commandBuffers = commandBuffers,
+        .waits = waits,
+        .signals = signals,
+    };
+    return submitBatch({&submission, 1}, fence);
+}
+
+auto canta::Queue::submitBatch(std::span<const Submission> submissions, VkFence fence) -> std::expected<bool, VulkanError> {
+    if (submissions.empty())
+        return true;
+
+    const auto semaphoreInfo = [](const SemaphorePair &pair) {
+        VkSemaphoreSubmitInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        info.semaphore = pair.semaphore->semaphore();
+        info.value = pair.value;
+        info.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        info.deviceIndex = 0;
+        info.pNext = nullptr;
+        return info;
+    };
+
+    u32 waitCount = 0;
     u32 signalCount = 0;
-    for (; signalCount < signals.size(); signalCount++) {
-        auto &signal = signals[signalCount];
-        signalInfos[signalCount].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        signalInfos[signalCount].semaphore = signal.semaphore->semaphore();
-        signalInfos[signalCount].value = signal.value;
-        signalInfos[signalCount].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        signalInfos[signalCount].deviceIndex = 0;
-        signalInfos[signalCount].pNext = nullptr;
-    }
-    if (_device->resourceTimeline()) {
-        // resource timeline signal on each queue submit
-        signalInfos[signalCount].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        signalInfos[signalCount].semaphore = _device->resourceTimeline()->semaphore();
-        signalInfos[signalCount].value = _device->resourceTimeline()->increment();
-        signalInfos[signalCount].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        signalInfos[signalCount].deviceIndex = 0;
-        signalInfos[signalCount].pNext = nullptr;
-        signalCount++;
+    u32 commandCount = 0;
+    for (const auto &submission : submissions) {
+        waitCount += submission.waits.size();
+        signalCount += submission.signals.size();
+        commandCount += submission.commandBuffers.size();
     }
 
-    VkCommandBufferSubmitInfo commandInfos[commandBuffers.size()];
-    for (u32 i = 0; i < commandBuffers.size(); i++) {
-        auto &commandBuffer = commandBuffers[i];
-        commandBuffer->end();
-        commandInfos[i].sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-        commandInfos[i].commandBuffer = commandBuffer->buffer();
-        commandInfos[i].deviceMask = 0;
-        commandInfos[i].pNext = nullptr;
-    }
+    // sized up front so pointers into them stay valid
+    std::vector<VkSemaphoreSubmitInfo> waitInfos = {};
+    waitInfos.reserve(waitCount);
+    std::vector<VkSemaphoreSubmitInfo> signalInfos = {};
+    signalInfos.reserve(signalCount + 1);
+    std::vector<VkCommandBufferSubmitInfo> commandInfos = {};
+    commandInfos.reserve(commandCount);
+    std::vector<VkSubmitInfo2> submitInfos(submissions.size());
+
+    for (u32 submissionIndex = 0; submissionIndex < submissions.size(); submissionIndex++) {
+        const auto &submission = submissions[submissionIndex];
+        auto &submitInfo = submitInfos[submissionIndex];
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+
+        submitInfo.pWaitSemaphoreInfos = waitInfos.data() + waitInfos.size();
+        for (const auto &wait : submission.waits)
+            waitInfos.push_back(semaphoreInfo(wait));
+        submitInfo.waitSemaphoreInfoCount = submission.waits.size();
 
-    VkSubmitInfo2 submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-    submitInfo.waitSemaphoreInfoCount = waits.size();
-    submitInfo.pWaitSemaphoreInfos = waitInfos;
-    submitInfo.signalSemaphoreInfoCount = signalCount;
-    submitInfo.pSignalSemaphoreInfos = signalInfos;
-    submitInfo.commandBufferInfoCount = commandBuffers.size();
-    submitInfo.pCommandBufferInfos = commandInfos;
+        submitInfo.pSignalSemaphoreInfos = signalInfos.data() + signalInfos.size();
+        for (const auto &signal : submission.signals)
+            signalInfos.push_back(semaphoreInfo(signal));
+        submitInfo.signalSemaphoreInfoCount = submission.signals.size();
+        // resource timeline signal once per batch, after all the work in it
+        if (submissionIndex == submissions.size() - 1 && _device->resourceTimeline()) {
+            signalInfos.push_back(semaphoreInfo(SemaphorePair(_device->resourceTimeline(), _device->resourceTimeline()->increment())));
+            submitInfo.signalSemaphoreInfoCount++;
+        }
+
+        submitInfo.pCommandBufferInfos = commandInfos.data() + commandInfos.size();
+        for (auto &commandBuffer : submission.commandBuffers) {
+            commandBuffer->end();
+            VkCommandBufferSubmitInfo commandInfo = {};
+            commandInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            commandInfo.commandBuffer = commandBuffer->buffer();
+            commandInfo.deviceMask = 0;
+            commandInfo.pNext = nullptr;
+            commandInfos.push_back(commandInfo);
+        }
+        submitInfo.commandBufferInfoCount = submission.commandBuffers.size();
+    }
 
     std::unique_lock<std::mutex> lock(_mutex);
 
-    auto result = vkQueueSubmit2(_queue, 1, &submitInfo, fence);
+    auto result = vkQueueSubmit2(_queue, submitInfos.size(), submitInfos.data(), fence);
     if (result != VK_SUCCESS)
         return std::unexpected(static_cast<VulkanError>(result));
     return true;
-}
\ No newline at end of file
+}
@@ -1,7 +1,10 @@
 #include <Canta/Enums.h>
 #include <Canta/ImGuiContext.h>
 #include <Canta/RenderGraph.h>
+#include <Ende/util/hash.h>
 #include <expected>
+#include <latch>
+#include <thread>
 
 constexpr auto defaultPassStage(const canta::RenderPass::Type type) -> canta::PipelineStage {
     switch (type) {
@@ -50,6 +53,126 @@ constexpr auto checkPassStageMatch(const canta::RenderPass::Type type, const can
     return false;
 }
 
+constexpr auto hasWriteAccess(const canta::Access access) -> bool {
+    return (access & canta::Access::SHADER_WRITE) == canta::Access::SHADER_WRITE ||
+           (access & canta::Access::COLOUR_WRITE) == canta::Access::COLOUR_WRITE ||
+           (access & canta::Access::DEPTH_STENCIL_WRITE) == canta::Access::DEPTH_STENCIL_WRITE ||
+           (access & canta::Access::TRANSFER_WRITE) == canta::Access::TRANSFER_WRITE ||
+           (access & canta::Access::HOST_WRITE) == canta::Access::HOST_WRITE ||
+           (access & canta::Access::MEMORY_WRITE) == canta::Access::MEMORY_WRITE ||
+           (access & canta::Access::TRANSFORM_FEEDBACK_WRITE) == canta::Access::TRANSFORM_FEEDBACK_WRITE ||
+           (access & canta::Access::TRANSFORM_FEEDBACK_COUNTER_WRITE) == canta::Access::TRANSFORM_FEEDBACK_COUNTER_WRITE ||
+           (access & canta::Access::ACCELERATION_STRUCTURE_WRITE) == canta::Access::ACCELERATION_STRUCTURE_WRITE;
+}
+
+// half open mip, layer and byte ranges of an access. ~0u ends extend to the end of the resource until clamped by
+// resourceBounds, images always cover every byte and buffers every mip and layer
+struct SubresourceBounds {
+    u32 mipBegin = 0;
+    u32 mipEnd = ~0u;
+    u32 layerBegin = 0;
+    u32 layerEnd = ~0u;
+    u32 byteBegin = 0;
+    u32 byteEnd = ~0u;
+};
+
+constexpr auto toBounds(const canta::ResourceAccess &access) -> SubresourceBounds {
+    const auto &subresource = access.subresource;
+    return {
+        .mipBegin = subresource.mip,
+        .mipEnd = subresource.mipCount == 0 ? ~0u : subresource.mip + subresource.mipCount,
+        .layerBegin = subresource.layer,
+        .layerEnd = subresource.layerCount == 0 ? ~0u : subresource.layer + subresource.layerCount,
+        .byteBegin = access.range.offset,
+        .byteEnd = access.range.size == 0 ? ~0u : access.range.offset + access.range.size,
+    };
+}
+
+constexpr auto toSubresource(const SubresourceBounds &bounds) -> canta::ImageSubresource {
+    return {
+        .mip = bounds.mipBegin,
+        .mipCount = bounds.mipEnd == ~0u ? 0 : bounds.mipEnd - bounds.mipBegin,
+        .layer = bounds.layerBegin,
+        .layerCount = bounds.layerEnd == ~0u ? 0 : bounds.layerEnd - bounds.layerBegin,
+    };
+}
+
+constexpr auto toRange(const SubresourceBounds &bounds) -> canta::BufferRange {
+    return {
+        .offset = bounds.byteBegin,
+        .size = bounds.byteEnd == ~0u ? 0 : bounds.byteEnd - bounds.byteBegin,
+    };
+}
+
+constexpr auto overlaps(const SubresourceBounds &lhs, const SubresourceBounds &rhs) -> bool {
+    return lhs.mipBegin < rhs.mipEnd && rhs.mipBegin < lhs.mipEnd &&
+           lhs.layerBegin < rhs.layerEnd && rhs.layerBegin < lhs.layerEnd &&
+           lhs.byteBegin < rhs.byteEnd && rhs.byteBegin < lhs.byteEnd;
+}
+
+constexpr auto intersection(const SubresourceBounds &lhs, const SubresourceBounds &rhs) -> SubresourceBounds {
+    return {
+        .mipBegin = std::max(lhs.mipBegin, rhs.mipBegin),
+        .mipEnd = std::min(lhs.mipEnd, rhs.mipEnd),
+        .layerBegin = std::max(lhs.layerBegin, rhs.layerBegin),
+        .layerEnd = std::min(lhs.layerEnd, rhs.layerEnd),
+        .byteBegin = std::max(lhs.byteBegin, rhs.byteBegin),
+        .byteEnd = std::min(lhs.byteEnd, rhs.byteEnd),
+    };
+}
+
+constexpr auto empty(const SubresourceBounds &bounds) -> bool {
+    return bounds.mipBegin >= bounds.mipEnd || bounds.layerBegin >= bounds.layerEnd || bounds.byteBegin >= bounds.byteEnd;
+}
+
+// mips and layers or bytes the resource actually has, external resources carry their own sizes
+inline auto resourceBounds(const canta::RenderGraph::ResourceInfo &info) -> SubresourceBounds {
+    if (const auto *imageInfo = std::get_if<canta::ImageInfo>(&info)) {
+        return {
+            .mipEnd = imageInfo->image ? imageInfo->image->mips() : imageInfo->mips,
+            .layerEnd = imageInfo->image ? imageInfo->image->layers() : 1,
+        };
+    }
+    const auto &bufferInfo = std::get<canta::BufferInfo>(info);
+    return {
+        .byteEnd = bufferInfo.buffer ? bufferInfo.buffer->size() : bufferInfo.size,
+    };
+}
+
+constexpr auto boundingBox(const SubresourceBounds &lhs, const SubresourceBounds &rhs) -> SubresourceBounds {
+    return {
+        .mipBegin = std::min(lhs.mipBegin, rhs.mipBegin),
+        .mipEnd = std::max(lhs.mipEnd, rhs.mipEnd),
+        .layerBegin = std::min(lhs.layerBegin, rhs.layerBegin),
+        .layerEnd = std::max(lhs.layerEnd, rhs.layerEnd),
+        .byteBegin = std::min(lhs.byteBegin, rhs.byteBegin),
+        .byteEnd = std::max(lhs.byteEnd, rhs.byteEnd),
+    };
+}
+
+// pieces of lhs not covered by rhs, at most six
+template <typename F>
+void subtract(const SubresourceBounds &lhs, const SubresourceBounds &rhs, F &&func) {
+    const auto overlap = intersection(lhs, rhs);
+    auto remaining = lhs;
+    if (remaining.mipBegin < overlap.mipBegin)
+        func(SubresourceBounds{remaining.mipBegin, overlap.mipBegin, remaining.layerBegin, remaining.layerEnd, remaining.byteBegin, remaining.byteEnd});
+    if (overlap.mipEnd < remaining.mipEnd)
+        func(SubresourceBounds{overlap.mipEnd, remaining.mipEnd, remaining.layerBegin, remaining.layerEnd, remaining.byteBegin, remaining.byteEnd});
+    remaining.mipBegin = overlap.mipBegin;
+    remaining.mipEnd = overlap.mipEnd;
+    if (remaining.layerBegin < overlap.layerBegin)
+        func(SubresourceBounds{remaining.mipBegin, remaining.mipEnd, remaining.layerBegin, overlap.layerBegin, remaining.byteBegin, remaining.byteEnd});
+    if (overlap.layerEnd < remaining.layerEnd)
+        func(SubresourceBounds{remaining.mipBegin, remaining.mipEnd, overlap.layerEnd, remaining.layerEnd, remaining.byteBegin, remaining.byteEnd});
+    remaining.layerBegin = overlap.layerBegin;
+    remaining.layerEnd = overlap.layerEnd;
+    if (remaining.byteBegin < overlap.byteBegin)
+        func(SubresourceBounds{remaining.mipBegin, remaining.mipEnd, remaining.layerBegin, remaining.layerEnd, remaining.byteBegin, overlap.byteBegin});
+    if (overlap.byteEnd < remaining.byteEnd)
+        func(SubresourceBounds{remaining.mipBegin, remaining.mipEnd, remaining.layerBegin, remaining.layerEnd, overlap.byteEnd, remaining.byteEnd});
+}
+
 auto canta::mapGraphErrorToRenderGraphError(const ende::graph::Error error) -> RenderGraphError {
     switch (error) {
     case ende::graph::Error::IS_CYCLICAL:
@@ -99,26 +222,6 @@ void canta::RenderPass::unpack(PushData &dst, i32 &i, const ImageHandle &handle)
     unpack(dst, i, id);
 }
 
-void unpack(canta::RenderPass::PushData &dst, i32 &i, const canta::BufferHandle &handle) {
-    const auto addr = handle->address();
-    auto *data = reinterpret_cast<const u8 *>(&addr);
-    for (auto j = 0; j < sizeof(addr); j++) {
-        dst.data[i + j] = data[j];
-    }
-    i += sizeof(addr);
-    // dst.size += sizeof(addr);
-}
-
-void unpack(canta::RenderPass::PushData &dst, i32 &i, const canta::ImageHandle &handle) {
-    const auto id = handle->defaultView().index();
-    auto *data = reinterpret_cast<const u8 *>(&id);
-    for (auto j = 0; j < sizeof(id); j++) {
-        dst.data[i + j] = data[j];
-    }
-    i += sizeof(id);
-    // dst.size += sizeof(id);
-}
-
 auto canta::RenderPass::setPipeline(const PipelineHandle &pipeline) -> RenderPass & {
     _pipeline = pipeline;
     return *this;
@@ -165,11 +268,10 @@ auto canta::RenderPass::run(RenderGraph &graph, CommandHandle commands) const ->
         commands->beginRendering(beginInfo);
     }
 
-    const auto pushData = maybe(resolvePushConstants(graph, _pushData, _deferredPushConstants));
     if (_pipeline)
         commands->bindPipeline(_pipeline);
     try {
-        maybe(_callback(commands, graph, pushData));
+        maybe(_callback(commands, graph, _pushData));
     } catch (std::exception &e) {
         return std::unexpected(RenderGraphError::PASS_RUN);
     }
@@ -195,15 +297,31 @@ auto canta::RenderPass::outputResourceIndex(u32 i) const -> u32 {
     }
 }
 
-auto canta::RenderPass::resolvePushConstants(const RenderGraph &graph, PushData data, const std::span<const DeferredPushConstant> deferredConstants) -> std::expected<PushData, RenderGraphError> {
-    for (const auto &deferredConstant : deferredConstants) {
-        auto offset = deferredConstant.offset;
-        if (deferredConstant.type == 0)
-            ::unpack(data, offset, maybe(graph.getBuffer(std::get<BufferIndex>(deferredConstant.value))));
-        else
-            ::unpack(data, offset, maybe(graph.getImage(std::get<ImageIndex>(deferredConstant.value))));
-    }
-    return data;
+void canta::RenderPass::setAllocationCounter(u64 *counter) {
+    _deferredPushConstants = PassVector<DeferredPushConstant>(PassAllocator<DeferredPushConstant>(counter));
+    _accesses = PassVector<ResourceAccess>(PassAllocator<ResourceAccess>(counter));
+    _colourAttachments = PassVector<Attachment>(PassAllocator<Attachment>(counter));
+    _renderingColourAttachments = PassVector<canta::Attachment>(PassAllocator<canta::Attachment>(counter));
+    _barriers = PassVector<Barrier>(PassAllocator<Barrier>(counter));
+    _queueWaits = PassVector<std::pair<i32, QueueType>>(PassAllocator<std::pair<i32, QueueType>>(counter));
+    _eventSignals = PassVector<u32>(PassAllocator<u32>(counter));
+    _eventWaits = PassVector<u32>(PassAllocator<u32>(counter));
+}
+
+void canta::RenderPass::reuseStorage(RenderPass &other) {
+    const auto reuse = [](auto &dst, auto &src) {
+        std::swap(dst, src);
+        dst.clear();
+    };
+    reuse(_deferredPushConstants, other._deferredPushConstants);
+    reuse(_accesses, other._accesses);
+    reuse(_colourAttachments, other._colourAttachments);
+    reuse(_renderingColourAttachments, other._renderingColourAttachments);
+    reuse(_barriers, other._barriers);
+    reuse(_queueWaits, other._queueWaits);
+    reuse(_eventSignals, other._eventSignals);
+    reuse(_eventWaits, other._eventWaits);
+    reuse(_name, other._name);
 }
 
 void canta::RenderPass::mergeAccesses() {
@@ -228,34 +346,35 @@ void canta::RenderPass::mergeAccesses() {
     };
 
     const auto hasWrite = [](const ResourceAccess &access) -> bool {
-        return (access.access & Access::SHADER_WRITE) == Access::SHADER_WRITE ||
-               (access.access & Access::COLOUR_WRITE) == Access::COLOUR_WRITE ||
-               (access.access & Access::DEPTH_STENCIL_WRITE) == Access::DEPTH_STENCIL_WRITE ||
-               (access.access & Access::TRANSFER_WRITE) == Access::TRANSFER_WRITE ||
-               (access.access & Access::HOST_WRITE) == Access::HOST_WRITE ||
-               (access.access & Access::MEMORY_WRITE) == Access::MEMORY_WRITE ||
-               (access.access & Access::TRANSFORM_FEEDBACK_WRITE) == Access::TRANSFORM_FEEDBACK_WRITE ||
-               (access.access & Access::TRANSFORM_FEEDBACK_COUNTER_WRITE) == Access::TRANSFORM_FEEDBACK_COUNTER_WRITE ||
-               (access.access & Access::ACCELERATION_STRUCTURE_WRITE) == Access::ACCELERATION_STRUCTURE_WRITE;
+        return hasWriteAccess(access.access);
     };
 
-    for (i32 accessIndex = 0; accessIndex < _accesses.size(); accessIndex++) {
-        auto &access = _accesses[accessIndex];
+    // accesses to disjoint subresources or ranges stay separate. merging grows the range so repeat until nothing overlaps
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (i32 accessIndex = 0; accessIndex < _accesses.size(); accessIndex++) {
+            auto &access = _accesses[accessIndex];
 
-        const auto writer = hasWrite(access);
+            const auto writer = hasWrite(access);
 
-        for (i32 nextIndex = accessIndex + 1; nextIndex < _accesses.size(); nextIndex++) {
-            auto &nextAccess = _accesses[nextIndex];
+            for (i32 nextIndex = accessIndex + 1; nextIndex < _accesses.size(); nextIndex++) {
+                auto &nextAccess = _accesses[nextIndex];
 
-            if (access.index == nextAccess.index) {
+                if (access.index == nextAccess.index && overlaps(toBounds(access), toBounds(nextAccess))) {
 
-                const auto nextWriter = hasWrite(nextAccess);
+                    const auto nextWriter = hasWrite(nextAccess);
 
-                access.access = nextWriter ? nextAccess.access : access.access;
-                access.stage = std::min(access.stage, nextAccess.stage);
-                access.layout = nextWriter ? nextAccess.layout : access.layout;
+                    access.access = nextWriter ? nextAccess.access : access.access;
+                    access.stage = std::min(access.stage, nextAccess.stage);
+                    access.layout = nextWriter ? nextAccess.layout : access.layout;
+                    const auto bounds = boundingBox(toBounds(access), toBounds(nextAccess));
+                    access.subresource = toSubresource(bounds);
+                    access.range = toRange(bounds);
 
-                _accesses.erase(_accesses.begin() + nextIndex--);
+                    _accesses.erase(_accesses.begin() + nextIndex--);
+                    merged = true;
+                }
             }
         }
     }
@@ -277,18 +396,25 @@ auto canta::PassBuilder::setManualPipeline(const bool state) -> PassBuilder & {
     return *this;
 }
 
-auto canta::PassBuilder::read(const BufferIndex index, const Access access, const PipelineStage stage) -> std::expected<BufferInfo, RenderGraphError> {
+auto canta::PassBuilder::setCostHint(const u64 nanoseconds) -> PassBuilder & {
+    pass().setCostHint(nanoseconds);
+    return *this;
+}
+
+auto canta::PassBuilder::read(const BufferIndex index, const Access access, const PipelineStage stage, const BufferRange &range) -> std::expected<BufferInfo, RenderGraphError> {
     maybe(_graph->validateGraphResource(index));
     pass().inputs.emplace_back(index);
     pass()._accesses.emplace_back(ResourceAccess{
         .id = index.id,
         .index = index.index,
         .access = access,
-        .stage = stage});
+        .stage = stage,
+        .range = range,
+    });
     return _graph->getBufferInfo(index);
 }
 
-auto canta::PassBuilder::read(const ImageIndex index, const Access access, const PipelineStage stage, const ImageLayout layout) -> std::expected<ImageInfo, RenderGraphError> {
+auto canta::PassBuilder::read(const ImageIndex index, const Access access, const PipelineStage stage, const ImageLayout layout, const ImageSubresource &subresource) -> std::expected<ImageInfo, RenderGraphError> {
     maybe(_graph->validateGraphResource(index));
     pass().inputs.emplace_back(index);
     pass()._accesses.emplace_back(ResourceAccess{
@@ -297,11 +423,12 @@ auto canta::PassBuilder::read(const ImageIndex index, const Access access, const
         .access = access,
         .stage = stage,
         .layout = layout,
+        .subresource = subresource,
     });
     return _graph->getImageInfo(index);
 }
 
-auto canta::PassBuilder::write(const BufferIndex index, const Access access, const PipelineStage stage) -> std::expected<BufferInfo, RenderGraphError> {
+auto canta::PassBuilder::write(const BufferIndex index, const Access access, const PipelineStage stage, const BufferRange &range) -> std::expected<BufferInfo, RenderGraphError> {
     maybe(_graph->validateGraphResource(index));
     const auto alias = _graph->alias(index);
     pass().outputs.emplace_back(alias);
@@ -309,11 +436,13 @@ auto canta::PassBuilder::write(const BufferIndex index, const Access access, con
         .id = alias.id,
         .index = alias.index,
         .access = access,
-        .stage = stage});
+        .stage = stage,
+        .range = range,
+    });
     return _graph->getBufferInfo(index);
 }
 
-auto canta::PassBuilder::write(const ImageIndex index, const Access access, const PipelineStage stage, const ImageLayout layout) -> std::expected<ImageInfo, RenderGraphError> {
+auto canta::PassBuilder::write(const ImageIndex index, const Access access, const PipelineStage stage, const ImageLayout layout, const ImageSubresource &subresource) -> std::expected<ImageInfo, RenderGraphError> {
     maybe(_graph->validateGraphResource(index));
     const auto alias = _graph->alias(index);
     pass().outputs.emplace_back(alias);
@@ -323,6 +452,7 @@ auto canta::PassBuilder::write(const ImageIndex index, const Access access, cons
         .access = access,
         .stage = stage,
         .layout = layout,
+        .subresource = subresource,
     });
     return _graph->getImageInfo(index);
 }
@@ -421,7 +551,7 @@ auto canta::PassBuilder::addColourRead(const ImageIndex index) -> PassBuilder &
     return *this;
 }
 
-auto canta::PassBuilder::addColourWrite(const ImageIndex index, const ClearValue &clearColour) -> PassBuilder & {
+auto canta::PassBuilder::addColourWrite(const ImageIndex index, const ClearValue &clearColour, const AttachmentHint &hint) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
@@ -430,6 +560,7 @@ auto canta::PassBuilder::addColourWrite(const ImageIndex index, const ClearValue
         .index = index.index,
         .layout = ImageLayout::COLOUR_ATTACHMENT,
         .clearColor = clearColour,
+        .hint = hint,
     });
     auto dimensions = pass().dimensions();
     pass()._dimensions = {
@@ -462,7 +593,7 @@ auto canta::PassBuilder::addDepthRead(const ImageIndex index) -> PassBuilder & {
     return *this;
 }
 
-auto canta::PassBuilder::addDepthWrite(const ImageIndex index, const ClearValue &clearColour) -> PassBuilder & {
+auto canta::PassBuilder::addDepthWrite(const ImageIndex index, const ClearValue &clearColour, const AttachmentHint &hint) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
@@ -471,6 +602,12 @@ auto canta::PassBuilder::addDepthWrite(const ImageIndex index, const ClearValue
         .index = index.index,
         .layout = ImageLayout::DEPTH_STENCIL_ATTACHMENT,
         .clearColor = clearColour,
+        .hint = hint,
+    };
+    auto dimensions = pass().dimensions();
+    pass()._dimensions = {
+        std::max(dimensions.x(), info.width),
+        std::max(dimensions.y(), info.height),
     };
 
     info.usage |= ImageUsage::DEPTH_STENCIL_ATTACHMENT;
@@ -478,13 +615,13 @@ auto canta::PassBuilder::addDepthWrite(const ImageIndex index, const ClearValue
     return *this;
 }
 
-auto canta::PassBuilder::addStorageImageRead(const ImageIndex index, PipelineStage stage) -> PassBuilder & {
+auto canta::PassBuilder::addStorageImageRead(const ImageIndex index, PipelineStage stage, const ImageSubresource &subresource) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
     if (stage == PipelineStage::NONE)
         stage = defaultPassStage(pass()._type);
-    auto info = *read(index, stage == PipelineStage::HOST ? Access::HOST_READ : Access::SHADER_READ, stage, ImageLayout::GENERAL);
+    auto info = *read(index, stage == PipelineStage::HOST ? Access::HOST_READ : Access::SHADER_READ, stage, ImageLayout::GENERAL, subresource);
     // can only use swapchain images as colour attachments or transfer targets.
     if (info.swapchainImage) {
         _error = RenderGraphError::INVALID_RESOURCE_USE;
@@ -496,13 +633,13 @@ auto canta::PassBuilder::addStorageImageRead(const ImageIndex index, PipelineSta
     return *this;
 }
 
-auto canta::PassBuilder::addStorageImageWrite(const ImageIndex index, PipelineStage stage) -> PassBuilder & {
+auto canta::PassBuilder::addStorageImageWrite(const ImageIndex index, PipelineStage stage, const ImageSubresource &subresource) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
     if (stage == PipelineStage::NONE)
         stage = defaultPassStage(pass()._type);
-    auto info = *write(index, stage == PipelineStage::HOST ? Access::HOST_READ | Access::HOST_WRITE : Access::SHADER_READ | Access::SHADER_WRITE, stage, ImageLayout::GENERAL);
+    auto info = *write(index, stage == PipelineStage::HOST ? Access::HOST_READ | Access::HOST_WRITE : Access::SHADER_READ | Access::SHADER_WRITE, stage, ImageLayout::GENERAL, subresource);
     // can only use swapchain images as colour attachments or transfer targets.
     if (info.swapchainImage) {
         _error = RenderGraphError::INVALID_RESOURCE_USE;
@@ -514,39 +651,39 @@ auto canta::PassBuilder::addStorageImageWrite(const ImageIndex index, PipelineSt
     return *this;
 }
 
-auto canta::PassBuilder::addStorageBufferRead(const BufferIndex index, PipelineStage stage) -> PassBuilder & {
+auto canta::PassBuilder::addStorageBufferRead(const BufferIndex index, PipelineStage stage, const BufferRange &range) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
     if (stage == PipelineStage::NONE)
         stage = defaultPassStage(pass()._type);
-    auto info = *read(index, stage == PipelineStage::HOST ? Access::HOST_READ : Access::SHADER_READ, stage);
+    auto info = *read(index, stage == PipelineStage::HOST ? Access::HOST_READ : Access::SHADER_READ, stage, range);
 
     info.usage |= BufferUsage::STORAGE;
     STORE_ERROR(_error, _graph->updateBufferInfo(index, info));
     return *this;
 }
 
-auto canta::PassBuilder::addStorageBufferWrite(const BufferIndex index, PipelineStage stage) -> PassBuilder & {
+auto canta::PassBuilder::addStorageBufferWrite(const BufferIndex index, PipelineStage stage, const BufferRange &range) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
     if (stage == PipelineStage::NONE)
         stage = defaultPassStage(pass()._type);
-    auto info = *write(index, stage == PipelineStage::HOST ? Access::HOST_READ | Access::HOST_WRITE : Access::SHADER_READ | Access::SHADER_WRITE, stage);
+    auto info = *write(index, stage == PipelineStage::HOST ? Access::HOST_READ | Access::HOST_WRITE : Access::SHADER_READ | Access::SHADER_WRITE, stage, range);
 
     info.usage |= BufferUsage::STORAGE;
     STORE_ERROR(_error, _graph->updateBufferInfo(index, info));
     return *this;
 }
 
-auto canta::PassBuilder::addSampledRead(const ImageIndex index, PipelineStage stage) -> PassBuilder & {
+auto canta::PassBuilder::addSampledRead(const ImageIndex index, PipelineStage stage, const ImageSubresource &subresource) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
     if (stage == PipelineStage::NONE)
         stage = defaultPassStage(pass()._type);
-    auto info = *read(index, Access::SHADER_READ, stage, ImageLayout::SHADER_READ_ONLY);
+    auto info = *read(index, Access::SHADER_READ, stage, ImageLayout::SHADER_READ_ONLY, subresource);
     // can only use swapchain images as colour attachments or transfer targets.
     if (info.swapchainImage) {
         _error = RenderGraphError::INVALID_RESOURCE_USE;
@@ -558,22 +695,22 @@ auto canta::PassBuilder::addSampledRead(const ImageIndex index, PipelineStage st
     return *this;
 }
 
-auto canta::PassBuilder::addBlitRead(const ImageIndex index) -> PassBuilder & {
+auto canta::PassBuilder::addBlitRead(const ImageIndex index, const ImageSubresource &subresource) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
-    auto info = *read(index, Access::TRANSFER_READ, PipelineStage::TRANSFER, ImageLayout::TRANSFER_SRC);
+    auto info = *read(index, Access::TRANSFER_READ, PipelineStage::TRANSFER, ImageLayout::TRANSFER_SRC, subresource);
 
     info.usage |= ImageUsage::TRANSFER_SRC;
     STORE_ERROR(_error, _graph->updateImageInfo(index, info));
     return *this;
 }
 
-auto canta::PassBuilder::addBlitWrite(const ImageIndex index) -> PassBuilder & {
+auto canta::PassBuilder::addBlitWrite(const ImageIndex index, const ImageSubresource &subresource) -> PassBuilder & {
     if (_error.has_value())
         return *this;
 
-    auto info = *write(index, Access::TRANSFER_WRITE, PipelineStage::TRANSFER, ImageLayout::TRANSFER_DST);
+    auto info = *write(index, Access::TRANSFER_WRITE, PipelineStage::TRANSFER, ImageLayout::TRANSFER_DST, subresource);
 
     info.usage |= ImageUsage::TRANSFER_DST;
     STORE_ERROR(_error, _graph->updateImageInfo(index, info));
@@ -669,28 +806,28 @@ auto canta::PassBuilder::addDummyWrite(const BufferIndex index) -> PassBuilder &
 
 canta::ComputePass::ComputePass(RenderGraph *graph, const u32 index) : PassBuilder(graph, index) {}
 
-auto canta::ComputePass::addStorageImageRead(const ImageIndex index) -> ComputePass & {
-    PassBuilder::addStorageImageRead(index, PipelineStage::COMPUTE_SHADER);
+auto canta::ComputePass::addStorageImageRead(const ImageIndex index, const ImageSubresource &subresource) -> ComputePass & {
+    PassBuilder::addStorageImageRead(index, PipelineStage::COMPUTE_SHADER, subresource);
     return *this;
 }
 
-auto canta::ComputePass::addStorageImageWrite(const ImageIndex index) -> ComputePass & {
-    PassBuilder::addStorageImageWrite(index, PipelineStage::COMPUTE_SHADER);
+auto canta::ComputePass::addStorageImageWrite(const ImageIndex index, const ImageSubresource &subresource) -> ComputePass & {
+    PassBuilder::addStorageImageWrite(index, PipelineStage::COMPUTE_SHADER, subresource);
     return *this;
 }
 
-auto canta::ComputePass::addStorageBufferRead(const BufferIndex index) -> ComputePass & {
-    PassBuilder::addStorageBufferRead(index, PipelineStage::COMPUTE_SHADER);
+auto canta::ComputePass::addStorageBufferRead(const BufferIndex index, const BufferRange &range) -> ComputePass & {
+    PassBuilder::addStorageBufferRead(index, PipelineStage::COMPUTE_SHADER, range);
     return *this;
 }
 
-auto canta::ComputePass::addStorageBufferWrite(const BufferIndex index) -> ComputePass & {
-    PassBuilder::addStorageBufferWrite(index, PipelineStage::COMPUTE_SHADER);
+auto canta::ComputePass::addStorageBufferWrite(const BufferIndex index, const BufferRange &range) -> ComputePass & {
+    PassBuilder::addStorageBufferWrite(index, PipelineStage::COMPUTE_SHADER, range);
     return *this;
 }
 
-auto canta::ComputePass::addSampledRead(const ImageIndex index) -> ComputePass & {
-    PassBuilder::addSampledRead(index, PipelineStage::COMPUTE_SHADER);
+auto canta::ComputePass::addSampledRead(const ImageIndex index, const ImageSubresource &subresource) -> ComputePass & {
+    PassBuilder::addSampledRead(index, PipelineStage::COMPUTE_SHADER, subresource);
     return *this;
 }
 
@@ -729,8 +866,8 @@ auto canta::GraphicsPass::addColourRead(const ImageIndex index) -> GraphicsPass
     return *this;
 }
 
-auto canta::GraphicsPass::addColourWrite(const ImageIndex index, const ClearValue &clearColour) -> GraphicsPass & {
-    PassBuilder::addColourWrite(index, clearColour);
+auto canta::GraphicsPass::addColourWrite(const ImageIndex index, const ClearValue &clearColour, const AttachmentHint &hint) -> GraphicsPass & {
+    PassBuilder::addColourWrite(index, clearColour, hint);
     return *this;
 }
 
@@ -739,33 +876,33 @@ auto canta::GraphicsPass::addDepthRead(const ImageIndex index) -> GraphicsPass &
     return *this;
 }
 
-auto canta::GraphicsPass::addDepthWrite(const ImageIndex index, const ClearValue &clearColour) -> GraphicsPass & {
-    PassBuilder::addDepthWrite(index, clearColour);
+auto canta::GraphicsPass::addDepthWrite(const ImageIndex index, const ClearValue &clearColour, const AttachmentHint &hint) -> GraphicsPass & {
+    PassBuilder::addDepthWrite(index, clearColour, hint);
     return *this;
 }
 
-auto canta::GraphicsPass::addStorageImageRead(const ImageIndex index, const PipelineStage stage) -> GraphicsPass & {
-    PassBuilder::addStorageImageRead(index, stage);
+auto canta::GraphicsPass::addStorageImageRead(const ImageIndex index, const PipelineStage stage, const ImageSubresource &subresource) -> GraphicsPass & {
+    PassBuilder::addStorageImageRead(index, stage, subresource);
     return *this;
 }
 
-auto canta::GraphicsPass::addStorageImageWrite(const ImageIndex index, const PipelineStage stage) -> GraphicsPass & {
-    PassBuilder::addStorageImageWrite(index, stage);
+auto canta::GraphicsPass::addStorageImageWrite(const ImageIndex index, const PipelineStage stage, const ImageSubresource &subresource) -> GraphicsPass & {
+    PassBuilder::addStorageImageWrite(index, stage, subresource);
     return *this;
 }
 
-auto canta::GraphicsPass::addStorageBufferRead(const BufferIndex index, const PipelineStage stage) -> GraphicsPass & {
-    PassBuilder::addStorageBufferRead(index, stage);
+auto canta::GraphicsPass::addStorageBufferRead(const BufferIndex index, const PipelineStage stage, const BufferRange &range) -> GraphicsPass & {
+    PassBuilder::addStorageBufferRead(index, stage, range);
     return *this;
 }
 
-auto canta::GraphicsPass::addStorageBufferWrite(const BufferIndex index, const PipelineStage stage) -> GraphicsPass & {
-    PassBuilder::addStorageBufferWrite(index, stage);
+auto canta::GraphicsPass::addStorageBufferWrite(const BufferIndex index, const PipelineStage stage, const BufferRange &range) -> GraphicsPass & {
+    PassBuilder::addStorageBufferWrite(index, stage, range);
     return *this;
 }
 
-auto canta::GraphicsPass::addSampledRead(const ImageIndex index, const PipelineStage stage) -> GraphicsPass & {
-    PassBuilder::addSampledRead(index, stage);
+auto canta::GraphicsPass::addSampledRead(const ImageIndex index, const PipelineStage stage, const ImageSubresource &subresource) -> GraphicsPass & {
+    PassBuilder::addSampledRead(index, stage, subresource);
     return *this;
 }
 
@@ -1134,10 +1271,17 @@ auto canta::RenderGraph::create(const CreateInfo &info) -> std::expected<RenderG
     graph._device = info.device;
     graph._threadPool = info.threadPool;
     graph._multiQueue = info.multiQueue;
+    graph._transientAliasing = info.transientAliasing;
+    graph._splitBarriers = info.splitBarriers;
+    graph._parallelRecording = info.parallelRecording;
+    graph._reorderPasses = info.reorderPasses;
+    graph._costScheduling = info.costScheduling;
+    graph._retained = info.retained;
     graph._graphIndex = s_graphIndex++;
     graph._name = info.name;
     if (!graph._threadPool)
         graph._threadPool = std::make_shared<ende::thread::ThreadPool>();
+    graph._hostExecutor = std::make_shared<HostPassExecutor>(info.device, graph._threadPool);
 
     for (auto &poolGroup : graph._commandPools) {
         poolGroup[0] = *info.device->createCommandPool({
@@ -1150,6 +1294,23 @@ auto canta::RenderGraph::create(const CreateInfo &info) -> std::expected<RenderG
             .queueType = QueueType::TRANSFER,
         });
     }
+    for (auto &pool : graph._eventPools) {
+        pool = maybe(info.device->createEventPool({.name = info.name})
+                         .transform_error([](VulkanError e) { return RenderGraphError::DEVICE_ERROR; }));
+    }
+
+    if (info.parameterSize > 0) {
+        const auto parameterName = std::string(info.name) + "_parameters";
+        for (auto &buffer : graph._parameterBuffers) {
+            buffer = info.device->createBuffer({
+                .size = info.parameterSize,
+                .usage = BufferUsage::STORAGE,
+                .type = MemoryType::STAGING,
+                .persistentlyMapped = true,
+                .name = parameterName,
+            });
+        }
+    }
 
     graph._cpuTimeline = maybe(info.device->createSemaphore({.initialValue = 0,
                                                              .name = "cpu_timeline"})
@@ -1199,6 +1360,7 @@ auto canta::RenderGraph::addImage(ImageCreateInfo info) -> ImageIndex {
         .width = info.width,
         .height = info.height,
         .depth = info.depth,
+        .mips = info.mips,
         .format = info.format,
         .swapchainImage = info.isSwapchain,
         .name = info.name,
@@ -1401,7 +1563,7 @@ auto canta::RenderGraph::updateImageInfo(const ImageIndex index, const ImageInfo
 }
 
 auto canta::RenderGraph::pass(const std::string_view name, const RenderPass::Type type, const PipelineHandle &pipeline, const RenderGroup &group) -> PassBuilder {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = type;
     pass._name = name;
     pass.setGroup(group);
@@ -1411,7 +1573,7 @@ auto canta::RenderGraph::pass(const std::string_view name, const RenderPass::Typ
 }
 
 auto canta::RenderGraph::compute(const std::string_view name, const PipelineHandle &pipeline, const RenderGroup &group) -> ComputePass {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = RenderPass::Type::COMPUTE;
     pass._name = name;
     pass.setGroup(group);
@@ -1421,7 +1583,7 @@ auto canta::RenderGraph::compute(const std::string_view name, const PipelineHand
 }
 
 auto canta::RenderGraph::graphics(const std::string_view name, const PipelineHandle &pipeline, const RenderGroup &group) -> GraphicsPass {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = RenderPass::Type::GRAPHICS;
     pass._name = name;
     pass.setGroup(group);
@@ -1431,7 +1593,7 @@ auto canta::RenderGraph::graphics(const std::string_view name, const PipelineHan
 }
 
 auto canta::RenderGraph::transfer(const std::string_view name, const PipelineHandle &pipeline, const RenderGroup &group) -> TransferPass {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = RenderPass::Type::TRANSFER;
     pass._name = name;
     pass.setGroup(group);
@@ -1441,7 +1603,7 @@ auto canta::RenderGraph::transfer(const std::string_view name, const PipelineHan
 }
 
 auto canta::RenderGraph::host(const std::string_view name) -> HostPass {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = RenderPass::Type::HOST;
     pass._queueType = QueueType::NONE;
     pass._name = name;
@@ -1450,15 +1612,16 @@ auto canta::RenderGraph::host(const std::string_view name) -> HostPass {
 }
 
 auto canta::RenderGraph::acquire(Swapchain *swapchain) -> std::expected<ImageIndex, RenderGraphError> {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = RenderPass::Type::PRESENT;
     pass._name = "acquire_pass";
+    pass._acquire = true;
     auto builder = PresentPass(this, vertexCount() - 1);
     return builder.acquire(swapchain);
 }
 
 auto canta::RenderGraph::present(Swapchain *swapchain, const ImageIndex index) -> std::expected<ImageIndex, RenderGraphError> {
-    auto &pass = addVertex();
+    auto &pass = newPass();
     pass._type = RenderPass::Type::PRESENT;
     pass._name = "present_pass";
     auto builder = PresentPass(this, vertexCount() - 1);
@@ -1477,13 +1640,38 @@ auto canta::RenderGraph::compile() -> std::expected<bool, RenderGraphError> {
     if (_rootEdge < 0)
         return std::unexpected(RenderGraphError::NO_ROOT);
 
+    if (_cpuBuildStart)
+        addCpuTiming("build", "build", _cpuBuildStart);
+    _cpuBuildStart = 0;
+    const auto compileStart = cpuTime();
+
+    for (u32 vertexIndex = 0; vertexIndex < vertexCount(); vertexIndex++)
+        getVertices()[vertexIndex]._vertexIndex = vertexIndex;
+
+    // timings from the frame that last used this slot, a shift in cost bumps the epoch and misses the cache
+    if (_multiQueue && _costScheduling)
+        updatePassCosts();
+
+    // same graph as last compile so only per frame data needs updating
+    const auto hash = structuralHash();
+    if (hash == _compiledHash && !_orderedPasses.empty()) {
+        const auto patched = patchCompiledPasses();
+        addCpuTiming("compile", "patch", compileStart);
+        return patched;
+    }
+    _compiledHash = 0;
+
+    auto phaseStart = cpuTime();
     auto sorted = maybe(sort(getEdges()[_rootEdge]).transform_error(mapGraphErrorToRenderGraphError));
+    addCpuTiming("compile", "sort", phaseStart);
 
     std::vector<std::pair<u32, u32>> indices = getResourceIndices(sorted);
 
     if (_multiQueue) {
+        phaseStart = cpuTime();
         const auto sortedSpan = std::span(sorted.data(), sorted.size());
         const auto dependencyLevels = maybe(buildDependencyLevels(sortedSpan));
+        addCpuTiming("compile", "dependency levels", phaseStart);
 
         for (auto &level : dependencyLevels) {
             for (auto &passIndex : level) {
@@ -1514,17 +1702,304 @@ auto canta::RenderGraph::compile() -> std::expected<bool, RenderGraphError> {
                     pass._queueType = QueueType::GRAPHICS;
             }
         }
+
+        if (_costScheduling)
+            scheduleAsyncCompute(sortedSpan, dependencyLevels);
     }
 
     _orderedPasses = sorted;
 
-    buildBarriers();
+    for (auto &pass : _orderedPasses)
+        pass.mergeAccesses();
+    _barriersBeforeReorder = 0;
+    _barriersAfterReorder = 0;
+    if (_reorderPasses) {
+        phaseStart = cpuTime();
+        maybe(schedulePasses());
+        addCpuTiming("compile", "reorder", phaseStart);
+    }
+    buildAccessTimelines();
+
+    // resources first as aliased resources patch their initial access
+    phaseStart = cpuTime();
     buildResources();
+    addCpuTiming("compile", "resources", phaseStart);
+    phaseStart = cpuTime();
+    buildBarriers();
+    buildSplitBarriers();
+    addCpuTiming("compile", "barriers", phaseStart);
+    phaseStart = cpuTime();
     maybe(buildRenderAttachments());
+    maybe(resolvePushConstants());
+    addCpuTiming("compile", "attachments", phaseStart);
+
+    _compiledHash = hash;
+    addCpuTiming("compile", "compile", compileStart);
+    return true;
+}
+
+auto canta::RenderGraph::schedulePasses() -> std::expected<bool, RenderGraphError> {
+    // passes in the same level dont depend on each other through edges so are preferred to be placed together
+    const auto levels = maybe(buildDependencyLevels(_orderedPasses));
+    std::vector<u32> passLevels(_orderedPasses.size(), 0);
+    for (u32 level = 0; level < levels.size(); level++) {
+        for (const auto passIndex : levels[level])
+            passLevels[passIndex] = level;
+    }
+
+    const auto isRead = [](const ResourceAccess &access) {
+        return !hasWriteAccess(access.access);
+    };
+
+    // edges only order writers before their readers. a pass writing a resource must also stay after earlier readers
+    // and writers of it, so every hazard in the current order becomes a constraint a pass waits on
+    std::vector<u32> pending(_orderedPasses.size(), 0);
+    std::vector<std::vector<u32>> successors(_orderedPasses.size());
+    {
+        std::vector<i32> lastWriters(_resources.size(), -1);
+        std::vector<std::vector<u32>> readers(_resources.size());
+        const auto addHazard = [&](const u32 before, const u32 after) {
+            if (before == after || std::ranges::find(successors[before], after) != successors[before].end())
+                return;
+            successors[before].push_back(after);
+            pending[after]++;
+        };
+        for (u32 passIndex = 0; passIndex < _orderedPasses.size(); passIndex++) {
+            for (const auto &access : _orderedPasses[passIndex]._accesses) {
+                if (lastWriters[access.index] > -1)
+                    addHazard(lastWriters[access.index], passIndex);
+                if (isRead(access)) {
+                    readers[access.index].push_back(passIndex);
+                    continue;
+                }
+                for (const auto reader : readers[access.index])
+                    addHazard(reader, passIndex);
+                readers[access.index].clear();
+                lastWriters[access.index] = passIndex;
+            }
+        }
+    }
+
+    // barriers buildBarriers emits for the current order, cleared again as resources arent built yet
+    const auto countBarriers = [this] {
+        buildBarriers();
+        u32 count = 0;
+        for (auto &pass : _orderedPasses) {
+            count += pass._barriers.size();
+            pass._barriers.clear();
+            pass._queueWaits.clear();
+        }
+        return count;
+    };
+    const auto countSwitches = [this](std::span<const u32> order) {
+        u32 switches = 0;
+        for (u32 i = 1; i < order.size(); i++) {
+            if (_orderedPasses[order[i]]._queueType != _orderedPasses[order[i - 1]]._queueType)
+                switches++;
+        }
+        return switches;
+    };
 
+    std::vector<u32> order = {};
+    order.reserve(_orderedPasses.size());
+    // position in order of the last write to each resource
+    std::vector<i32> lastWrites(_resources.size(), -1);
+    const RenderPass *lastPass = nullptr;
+
+    // the current order satisfies every hazard so there is always a ready pass
+    std::vector<u32> ready = {};
+    for (u32 passIndex = 0; passIndex < _orderedPasses.size(); passIndex++) {
+        if (pending[passIndex] == 0)
+            ready.push_back(passIndex);
+    }
+    while (!ready.empty()) {
+        // prefer the earliest level, then staying on the same queue, then sharing reads with the last pass, then passes
+        // whose inputs were written longest ago
+        const auto score = [&](const u32 passIndex) {
+            const auto &pass = _orderedPasses[passIndex];
+            const bool sameQueue = lastPass && lastPass->_queueType == pass._queueType;
+            i32 sharedReads = 0;
+            i32 newestInput = -1;
+            for (const auto &access : pass._accesses) {
+                newestInput = std::max(newestInput, lastWrites[access.index]);
+                if (!lastPass || !isRead(access))
+                    continue;
+                for (const auto &lastAccess : lastPass->_accesses) {
+                    if (lastAccess.index == access.index && isRead(lastAccess) && lastAccess.layout == access.layout)
+                        sharedReads++;
+                }
+            }
+            return std::make_tuple(-static_cast<i32>(passLevels[passIndex]), sameQueue, sharedReads, -newestInput, -static_cast<i32>(passIndex));
+        };
+
+        auto best = std::ranges::max_element(ready, std::less{}, score);
+        const auto passIndex = *best;
+        ready.erase(best);
+
+        order.push_back(passIndex);
+        lastPass = &_orderedPasses[passIndex];
+        for (const auto &access : lastPass->_accesses) {
+            if (!isRead(access))
+                lastWrites[access.index] = order.size() - 1;
+        }
+        for (const auto successor : successors[passIndex]) {
+            if (--pending[successor] == 0)
+                ready.push_back(successor);
+        }
+    }
+    if (order.size() != _orderedPasses.size())
+        return std::unexpected(RenderGraphError::IS_CYCLICAL);
+
+    std::vector<u32> identity(_orderedPasses.size());
+    std::iota(identity.begin(), identity.end(), 0);
+    const auto originalBarriers = countBarriers();
+    const auto originalSwitches = countSwitches(identity);
+    _barriersBeforeReorder = originalBarriers;
+    _barriersAfterReorder = originalBarriers;
+    if (order == identity)
+        return false;
+
+    std::vector<RenderPass> reordered = {};
+    reordered.reserve(_orderedPasses.size());
+    for (const auto passIndex : order)
+        reordered.push_back(std::move(_orderedPasses[passIndex]));
+    std::swap(_orderedPasses, reordered);
+
+    const auto barriers = countBarriers();
+    const auto switches = countSwitches(identity);
+    if (barriers + switches > originalBarriers + originalSwitches || barriers > originalBarriers) {
+        for (u32 i = 0; i < order.size(); i++)
+            reordered[order[i]] = std::move(_orderedPasses[i]);
+        std::swap(_orderedPasses, reordered);
+        return false;
+    }
+    _barriersAfterReorder = barriers;
     return true;
 }
 
+auto canta::RenderGraph::structuralHash() -> u64 {
+    const auto combine = [](const u64 hash, const auto value) {
+        return ende::util::combineHash(hash, static_cast<u64>(value));
+    };
+    const auto combineAccess = [&combine](u64 hash, const ResourceAccess &access) {
+        hash = combine(hash, access.index);
+        hash = combine(hash, access.access);
+        hash = combine(hash, access.stage);
+        hash = combine(hash, access.layout);
+        hash = combine(hash, access.subresource.mip);
+        hash = combine(hash, access.subresource.mipCount);
+        hash = combine(hash, access.subresource.layer);
+        hash = combine(hash, access.subresource.layerCount);
+        hash = combine(hash, access.range.offset);
+        return combine(hash, access.range.size);
+    };
+    const auto combineEdge = [&combine](const u64 hash, const Edge &edge) {
+        return std::visit([&](const auto &index) {
+            return combine(combine(combine(hash, edge.index()), index.id), index.index);
+        },
+                          edge);
+    };
+
+    u64 hash = combine(vertexCount(), edgeCount());
+    hash = combine(hash, _rootEdge);
+    hash = combine(hash, _multiQueue);
+    hash = combine(hash, _transientAliasing);
+    hash = combine(hash, _splitBarriers);
+    hash = combine(hash, _reorderPasses);
+    hash = combine(hash, _costScheduling);
+    hash = combine(hash, _costEpoch);
+
+    for (const auto &resource : _resources) {
+        hash = combine(hash, resource.info.index());
+        if (std::holds_alternative<BufferInfo>(resource.info)) {
+            const auto &info = std::get<BufferInfo>(resource.info);
+            hash = combine(hash, info.size);
+            hash = combine(hash, info.usage);
+            hash = combine(hash, info.type);
+            hash = combine(hash, info.external);
+        } else {
+            const auto &info = std::get<ImageInfo>(resource.info);
+            hash = combine(hash, info.width);
+            hash = combine(hash, info.height);
+            hash = combine(hash, info.depth);
+            hash = combine(hash, info.mips);
+            hash = combine(hash, info.format);
+            hash = combine(hash, info.usage);
+            hash = combine(hash, info.external);
+            hash = combine(hash, info.swapchainImage);
+        }
+        hash = combineAccess(hash, resource.initialAccess);
+    }
+
+    for (const auto &pass : getVertices()) {
+        hash = combine(hash, pass._type);
+        hash = combine(hash, pass._queueType);
+        hash = combine(hash, pass._group.id);
+        hash = combine(hash, pass._costHint);
+        for (const auto &access : pass._accesses)
+            hash = combineAccess(hash, access);
+        for (const auto &input : pass.inputs)
+            hash = combineEdge(hash, input);
+        for (const auto &output : pass.outputs)
+            hash = combineEdge(hash, output);
+        for (const auto &attachment : pass._colourAttachments) {
+            hash = combine(hash, attachment.index);
+            hash = combine(hash, attachment.layout);
+            hash = combine(hash, attachment.hint.load);
+            hash = combine(hash, attachment.hint.store);
+        }
+        hash = combine(hash, pass._depthAttachment.index);
+        hash = combine(hash, pass._depthAttachment.layout);
+        hash = combine(hash, pass._depthAttachment.hint.load);
+        hash = combine(hash, pass._depthAttachment.hint.store);
+    }
+
+    return hash;
+}
+
+auto canta::RenderGraph::patchCompiledPasses() -> std::expected<bool, RenderGraphError> {
+    for (auto &pass : _orderedPasses) {
+        const auto &source = getVertices()[pass._vertexIndex];
+        pass._name = source._name;
+        pass._group = source._group;
+        pass._pipeline = source._pipeline;
+        pass._manualPipeline = source._manualPipeline;
+        pass._deferredPushConstants = source._deferredPushConstants;
+        pass._pushData = source._pushData;
+        pass._callback = source._callback;
+        pass._dimensions = source._dimensions;
+    }
+
+    buildResources();
+
+    // rendering attachments reference resources so need to be refreshed
+    for (auto &pass : _orderedPasses) {
+        const auto &source = getVertices()[pass._vertexIndex];
+        for (u32 attachmentIndex = 0; attachmentIndex < pass._colourAttachments.size(); attachmentIndex++) {
+            auto &attachment = pass._colourAttachments[attachmentIndex];
+            auto &renderingAttachment = pass._renderingColourAttachments[attachmentIndex];
+            attachment.clearColor = source._colourAttachments[attachmentIndex].clearColor;
+            renderingAttachment.clearColour = attachment.clearColor;
+            renderingAttachment.image = maybe(getImageInfo({.index = attachment.index})).image;
+        }
+        if (pass._depthAttachment.index > -1) {
+            pass._depthAttachment.clearColor = source._depthAttachment.clearColor;
+            pass._renderingDepthAttachment.clearColour = pass._depthAttachment.clearColor;
+            pass._renderingDepthAttachment.image = maybe(getImageInfo({.index = pass._depthAttachment.index})).image;
+        }
+    }
+
+    return resolvePushConstants();
+}
+
+inline auto steadyTime() -> u64 {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline auto currentThread() -> u32 {
+    return static_cast<u32>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+
 inline auto getQueueIndex(const canta::QueueType queue) -> u32 {
     switch (queue) {
     case canta::QueueType::NONE:
@@ -1544,7 +2019,11 @@ inline auto getQueueIndex(const canta::QueueType queue) -> u32 {
 }
 
 auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<SemaphorePair> signals, const bool async) -> std::expected<bool, RenderGraphError> {
+    const auto runStart = cpuTime();
     _device->updateBindlessDescriptors();
+    _lastRunFrame = _device->frameValue();
+    if (_cpuProfiling)
+        _passCpuTimings.assign(_orderedPasses.size(), {});
     // for each sorted pass
     // if current queue different than last end current command list and start a new one.
     // new command list waits on timeline from previous queue.
@@ -1553,16 +2032,146 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
     for (auto &pool : _commandPools[_device->flyingIndex()])
         pool.reset();
 
+    // events are reset after being waited on so are unsignaled by the time this frame index comes around again
+    auto &eventPool = _eventPools[_device->flyingIndex()];
+    eventPool.reset();
+    std::vector<VkEvent> events(_eventBarriers.size());
+    for (auto &event : events)
+        event = eventPool.getEvent();
+
+    _timerCount = 0;
+    _statsCount = 0;
+
+    // per group queries span command buffers so can only be recorded in order. retained command buffers are replayed while
+    // the key they were recorded with still matches
+    const bool batched = (_parallelRecording || _retained) && _timingMode != QueryMode::PER_GROUP && _statsMode != QueryMode::PER_GROUP;
+    // batches are recorded before the pass loop reaches the acquire, so the swapchain image is acquired first. the
+    // retained key then hashes the image just acquired, a different image than last time means re-recording
+    if (batched) {
+        for (auto &pass : _orderedPasses) {
+            if (pass._acquire)
+                maybe(pass.run(*this, CommandHandle()));
+        }
+    }
+    const u64 key = batched && _retained ? retainedKey() : 0;
+    const bool replay = key != 0 && key == _retainedKeys[_device->flyingIndex()];
+    auto batches = !batched ? std::vector<RecordBatch>{} : replay ? _retainedBatches[_device->flyingIndex()] : buildRecordBatches();
+    std::vector<i32> passBatches(_orderedPasses.size(), -1);
+    u32 queryCount = 0;
+    for (u32 batchIndex = 0; batchIndex < batches.size(); batchIndex++) {
+        const auto &batch = batches[batchIndex];
+        for (u32 passIndex = batch.first; passIndex < batch.last; passIndex++)
+            passBatches[passIndex] = batchIndex;
+        queryCount = batch.queryIndex + batch.last - batch.first;
+    }
+    _recordedBatches = 0;
+    if (batched && !replay) {
+        auto &pools = _recordingPools[_device->flyingIndex()];
+        for (auto &pool : pools) {
+            if (pool.queueType() != QueueType::NONE)
+                pool.reset();
+        }
+        for (u32 batchIndex = 0; batchIndex < batches.size(); batchIndex++) {
+            auto &batch = batches[batchIndex];
+            if (pools.size() <= batchIndex)
+                pools.emplace_back();
+            if (pools[batchIndex].queueType() != batch.queue) {
+                pools[batchIndex] = maybe(_device->createCommandPool({.queueType = batch.queue})
+                                              .transform_error([](VulkanError e) { return RenderGraphError::DEVICE_ERROR; }));
+            }
+            batch.commands = pools[batchIndex].getBuffer();
+        }
+
+        // queries are created up front as the device isnt safe to call from the recording threads
+        if (_timingMode == QueryMode::PER_PASS) {
+            auto &frameTimers = _timers[_device->flyingIndex()];
+            while (frameTimers.size() < queryCount)
+                frameTimers.emplace_back(TimerInfo{{}, QueueType::NONE, _device->createTimer()});
+        }
+        if (_statsMode == QueryMode::PER_PASS) {
+            auto &frameStatistics = _statistics[_device->flyingIndex()];
+            while (frameStatistics.size() < queryCount)
+                frameStatistics.emplace_back(StatisticInfo{{}, QueueType::NONE, _device->createPipelineStatistics()});
+        }
+        for (const auto &batch : batches) {
+            for (u32 passIndex = batch.first; passIndex < batch.last; passIndex++) {
+                const auto queryIndex = batch.queryIndex + passIndex - batch.first;
+                if (_timingMode == QueryMode::PER_PASS) {
+                    _timers[_device->flyingIndex()][queryIndex].name = _orderedPasses[passIndex].name();
+                    _timers[_device->flyingIndex()][queryIndex].queue = batch.queue;
+                    _timers[_device->flyingIndex()][queryIndex].pass = _orderedPasses[passIndex]._vertexIndex;
+                }
+                if (_statsMode == QueryMode::PER_PASS) {
+                    _statistics[_device->flyingIndex()][queryIndex].name = _orderedPasses[passIndex].name();
+                    _statistics[_device->flyingIndex()][queryIndex].queue = batch.queue;
+                }
+            }
+        }
+
+        if (_parallelRecording) {
+            // first batch is recorded on this thread while the rest are on the pool
+            std::latch recorded(batches.empty() ? 0 : batches.size() - 1);
+            for (u32 batchIndex = 1; batchIndex < batches.size(); batchIndex++) {
+                _threadPool->addJob([this, &batches, &recorded, &events, batchIndex]() -> std::expected<bool, RenderGraphError> {
+                    batches[batchIndex].result = recordBatch(batches[batchIndex], events);
+                    recorded.count_down();
+                    return true;
+                });
+            }
+            if (!batches.empty())
+                batches.front().result = recordBatch(batches.front(), events);
+            recorded.wait();
+        } else {
+            for (auto &batch : batches)
+                batch.result = recordBatch(batch, events);
+        }
+
+        for (const auto &batch : batches)
+            maybe(batch.result);
+        _recordedBatches = batches.size();
+
+        // pools were reset so anything retained for this frame is gone either way
+        _retainedKeys[_device->flyingIndex()] = key;
+        _retainedBatches[_device->flyingIndex()] = _retained ? batches : std::vector<RecordBatch>{};
+    }
+    if (replay && _timingMode == QueryMode::PER_PASS) {
+        for (u32 queryIndex = 0; queryIndex < queryCount; queryIndex++)
+            _timers[_device->flyingIndex()][queryIndex].timer.reset();
+    }
+    if (batched) {
+        if (_timingMode == QueryMode::PER_PASS)
+            _timerCount = queryCount;
+        if (_statsMode == QueryMode::PER_PASS)
+            _statsCount = queryCount;
+    }
+
     CommandHandle currentCommandBuffer = {};
     QueueType currentQueue = QueueType::NONE;
     RenderGroup currentGroup = {};
-    _timerCount = 0;
-    _statsCount = 0;
+    // batches recorded since the last submit, a run on one queue can be split into several
+    i32 currentBatch = -1;
+    std::vector<CommandHandle> batchCommands = {};
+    const auto currentCommands = [&]() -> std::span<const CommandHandle> {
+        if (batched)
+            return batchCommands;
+        return {&currentCommandBuffer, 1};
+    };
 
     std::vector<SemaphorePair> waitHandles = {};
     std::vector<SemaphorePair> signalHandles = {};
 
-    const auto submitCommands = [this, async](CommandHandle commands, const QueueType queueType, std::span<SemaphorePair> waits, std::span<SemaphorePair> signals, const bool final) -> std::expected<bool, RenderGraphError> {
+    // submissions are collected and flushed with one vkQueueSubmit2 per queue. timeline values are still taken in pass order so
+    // waits and signals are unchanged, a wait may just be submitted before its signal which timeline semaphores allow
+    struct PendingSubmit {
+        QueueType queue = QueueType::NONE;
+        std::vector<CommandHandle> commands = {};
+        std::vector<SemaphorePair> waits = {};
+        std::vector<SemaphorePair> signals = {};
+    };
+    std::vector<PendingSubmit> pendingSubmits = {};
+    _submitCount = 0;
+
+    const auto submitCommands = [this, async, &pendingSubmits](std::span<const CommandHandle> commands, const QueueType queueType, std::span<SemaphorePair> waits, std::span<SemaphorePair> signals, const bool final) -> std::expected<bool, RenderGraphError> {
         const auto queue = _device->queue(queueType);
 
         std::vector<SemaphorePair> passWaits = {};
@@ -1574,10 +2183,41 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
         if (async && final)
             passSignals.emplace_back(_cpuTimeline, _cpuTimeline->increment());
 
-        maybe(queue->submit({&commands, 1}, passWaits, passSignals).transform_error([this](VulkanError error) {
-            _device->logger().error("Invalid queue submit: {}", static_cast<u32>(error));
-            return RenderGraphError::DEVICE_ERROR;
-        }));
+        pendingSubmits.push_back({
+            .queue = queueType,
+            .commands = {commands.begin(), commands.end()},
+            .waits = std::move(passWaits),
+            .signals = std::move(passSignals),
+        });
+        return true;
+    };
+
+    const auto flushSubmits = [this, &pendingSubmits]() -> std::expected<bool, RenderGraphError> {
+        std::vector<QueueType> queues = {};
+        for (const auto &pending : pendingSubmits) {
+            if (std::ranges::find(queues, pending.queue) == queues.end())
+                queues.push_back(pending.queue);
+        }
+        for (const auto queueType : queues) {
+            const auto submitStart = cpuTime();
+            std::vector<Queue::Submission> submissions = {};
+            for (auto &pending : pendingSubmits) {
+                if (pending.queue != queueType)
+                    continue;
+                submissions.push_back({
+                    .commandBuffers = pending.commands,
+                    .waits = pending.waits,
+                    .signals = pending.signals,
+                });
+            }
+            maybe(_device->queue(queueType)->submitBatch(submissions).transform_error([this](VulkanError error) {
+                _device->logger().error("Invalid queue submit: {}", static_cast<u32>(error));
+                return RenderGraphError::DEVICE_ERROR;
+            }));
+            addCpuTiming("submit", queueTypeString(queueType), submitStart);
+            _submitCount++;
+        }
+        pendingSubmits.clear();
         return true;
     };
 
@@ -1593,20 +2233,21 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
 
         if (pass._type == RenderPass::Type::PRESENT) {
             if (currentCommandBuffer) {
-
-                submitBarriers(currentCommandBuffer, pass._barriers);
-                if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
-                    endStats(currentCommandBuffer, _statsCount++);
-                if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
-                    endTimer(currentCommandBuffer, _timerCount++);
-
-                if (currentGroup.id > -1) {
-                    currentCommandBuffer->popDebugLabel();
-                    currentGroup = {};
+                if (!batched) {
+                    submitBarriers(currentCommandBuffer, pass._barriers);
+                    if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
+                        endStats(currentCommandBuffer, _statsCount++);
+                    if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
+                        endTimer(currentCommandBuffer, _timerCount++);
+
+                    if (currentGroup.id > -1) {
+                        currentCommandBuffer->popDebugLabel();
+                        currentGroup = {};
+                    }
+                    currentCommandBuffer->end();
                 }
-                currentCommandBuffer->end();
 
-                maybe(submitCommands(currentCommandBuffer, currentQueue, waitHandles, signalHandles, passIndex == _orderedPasses.size() - 1));
+                maybe(submitCommands(currentCommands(), currentQueue, waitHandles, signalHandles, passIndex == _orderedPasses.size() - 1));
             }
 
             u32 count = pass._queueWaits.size();
@@ -1615,7 +2256,10 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
                 queueIndices.emplace_back(static_cast<u32>(wait.second));
 
             pass.pushConstants(count, queueIndices);
-            maybe(pass.run(*this, CommandHandle()));
+            // presenting waits on binary semaphores signalled by the graphs work so it must be submitted first
+            maybe(flushSubmits());
+            if (!batched || !pass._acquire)
+                maybe(pass.run(*this, CommandHandle()));
 
             currentCommandBuffer = {};
             continue;
@@ -1623,18 +2267,20 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
 
         if (pass._type == RenderPass::Type::HOST) {
             if (currentCommandBuffer) {
-                submitBarriers(currentCommandBuffer, pass._barriers);
-                if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
-                    endStats(currentCommandBuffer, _statsCount++);
-                if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
-                    endTimer(currentCommandBuffer, _timerCount++);
-                if (currentGroup.id > -1) {
-                    currentCommandBuffer->popDebugLabel();
-                    currentGroup = {};
+                if (!batched) {
+                    submitBarriers(currentCommandBuffer, pass._barriers);
+                    if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
+                        endStats(currentCommandBuffer, _statsCount++);
+                    if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
+                        endTimer(currentCommandBuffer, _timerCount++);
+                    if (currentGroup.id > -1) {
+                        currentCommandBuffer->popDebugLabel();
+                        currentGroup = {};
+                    }
+                    currentCommandBuffer->end();
                 }
-                currentCommandBuffer->end();
 
-                maybe(submitCommands(currentCommandBuffer, currentQueue, waitHandles, signalHandles, passIndex == _orderedPasses.size() - 1));
+                maybe(submitCommands(currentCommands(), currentQueue, waitHandles, signalHandles, passIndex == _orderedPasses.size() - 1));
             }
 
             if (passIndex != 0)
@@ -1649,25 +2295,23 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
             }
             auto semaphores = waitHandles;
 
+            // host passes run in order so each also waits on the one before it
             auto cpuValue = _cpuTimeline->increment();
-            _threadPool->addJob([this, semaphores, cpuValue, pass]() -> std::expected<bool, RenderGraphError> {
-                maybe(_cpuTimeline->wait(cpuValue - 1).transform_error([this](VulkanError error) -> RenderGraphError {
-                    _device->logger().error("Wait on invalid timeline: {}", static_cast<u32>(error));
-                    return RenderGraphError::DEVICE_ERROR;
-                }));
-                for (auto &wait : semaphores) {
-                    maybe(wait.semaphore->wait(wait.value).transform_error([this](VulkanError error) -> RenderGraphError {
-                        _device->logger().error("Wait on invalid timeline: {}", static_cast<u32>(error));
-                        return RenderGraphError::DEVICE_ERROR;
-                    }));
+            semaphores.emplace_back(_cpuTimeline, cpuValue - 1);
+            auto cpuSignal = std::vector{SemaphorePair(_cpuTimeline, cpuValue)};
+            _hostExecutor->enqueue(std::move(semaphores), std::move(cpuSignal), [this, cpuValue, pass, timings = _cpuProfiling ? _hostCpuTimings : nullptr]() {
+                const auto hostStart = timings ? steadyTime() : 0;
+                if (const auto result = pass.run(*this, CommandHandle()); !result)
+                    _device->logger().error("Host pass {} failed: {}", pass.name(), static_cast<u32>(result.error()));
+                if (timings) {
+                    const auto duration = steadyTime() - hostStart;
+                    std::scoped_lock lock(timings->mutex);
+                    timings->timings.push_back({.category = "host", .name = pass._name, .start = hostStart, .duration = duration, .thread = currentThread()});
                 }
-                maybe(pass.run(*this, CommandHandle()));
 
-                maybe(_cpuTimeline->signal(cpuValue).transform_error([this](VulkanError error) -> RenderGraphError {
-                    _device->logger().error("Signal on invalid timeline: {}", static_cast<u32>(error));
-                    return RenderGraphError::DEVICE_ERROR;
-                }));
-                return false;
+                // signalled even on failure so later passes dont wait forever
+                if (const auto result = _cpuTimeline->signal(cpuValue); !result)
+                    _device->logger().error("Signal on invalid timeline: {}", static_cast<u32>(result.error()));
             });
 
             currentCommandBuffer = {};
@@ -1675,21 +2319,48 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
         }
 
         if (pass._queueType != currentQueue && currentCommandBuffer) {
-            if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
-                endStats(currentCommandBuffer, _statsCount++);
-            if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
-                endTimer(currentCommandBuffer, _timerCount++);
-            if (currentGroup.id > -1) {
-                currentCommandBuffer->popDebugLabel();
-                currentGroup = {};
+            if (!batched) {
+                if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
+                    endStats(currentCommandBuffer, _statsCount++);
+                if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
+                    endTimer(currentCommandBuffer, _timerCount++);
+                if (currentGroup.id > -1) {
+                    currentCommandBuffer->popDebugLabel();
+                    currentGroup = {};
+                }
+                currentCommandBuffer->end();
             }
-            currentCommandBuffer->end();
 
-            maybe(submitCommands(currentCommandBuffer, currentQueue, waitHandles, signalHandles, passIndex == _orderedPasses.size() - 1));
+            maybe(submitCommands(currentCommands(), currentQueue, waitHandles, signalHandles, passIndex == _orderedPasses.size() - 1));
 
             currentCommandBuffer = {};
         }
 
+        if (!currentCommandBuffer && batched) {
+            currentQueue = pass._queueType;
+            currentBatch = passBatches[passIndex];
+            currentCommandBuffer = batches[currentBatch].commands;
+            batchCommands = {currentCommandBuffer};
+
+            if (passIndex != 0)
+                waitHandles.clear();
+        } else if (batched && passBatches[passIndex] != currentBatch) {
+            currentBatch = passBatches[passIndex];
+            batchCommands.push_back(batches[currentBatch].commands);
+        }
+
+        if (batched) {
+            for (auto &wait : pass._queueWaits) {
+                if (wait.second == QueueType::NONE) {
+                    waitHandles.emplace_back(_cpuTimeline);
+                    continue;
+                }
+                auto waitedQueue = _device->queue(wait.second);
+                waitHandles.emplace_back(waitedQueue->timeline());
+            }
+            continue;
+        }
+
         if (!currentCommandBuffer) {
             currentQueue = pass._queueType;
             const auto queueIndex = getQueueIndex(pass._queueType);
@@ -1727,11 +2398,14 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
         currentCommandBuffer->pushDebugLabel(pass._name, {1, 1, 1, 1});
 
         if (_timingMode == QueryMode::PER_PASS)
-            startTimer(currentCommandBuffer, _timerCount, pass.name(), currentQueue);
+            startTimer(currentCommandBuffer, _timerCount, pass.name(), currentQueue, pass._vertexIndex);
         if (_statsMode == QueryMode::PER_PASS)
             startStats(currentCommandBuffer, _statsCount, pass.name(), currentQueue);
 
+        const auto recordStart = cpuTime();
         submitBarriers(currentCommandBuffer, pass._barriers);
+        for (const auto eventIndex : pass._eventWaits)
+            waitBarriers(currentCommandBuffer, events[eventIndex], _eventBarriers[eventIndex].barriers);
 
         for (auto &wait : pass._queueWaits) {
             if (wait.second == QueueType::NONE) {
@@ -1744,22 +2418,30 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
 
         maybe(pass.run(*this, currentCommandBuffer));
 
+        for (const auto eventIndex : pass._eventSignals)
+            signalBarriers(currentCommandBuffer, events[eventIndex], _eventBarriers[eventIndex].barriers);
+
         if (_statsMode == QueryMode::PER_PASS)
             endStats(currentCommandBuffer, _statsCount++);
         if (_timingMode == QueryMode::PER_PASS)
             endTimer(currentCommandBuffer, _timerCount++);
+        if (_cpuProfiling)
+            _passCpuTimings[passIndex] = {.category = "record", .name = pass._name, .start = recordStart, .duration = cpuTime() - recordStart, .thread = currentThread()};
 
         currentCommandBuffer->popDebugLabel();
     }
     if (currentCommandBuffer) {
-        if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
-            endStats(currentCommandBuffer, _statsCount++);
-        if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
-            endTimer(currentCommandBuffer, _timerCount++);
-        currentCommandBuffer->end();
+        if (!batched) {
+            if (_statsMode == QueryMode::PER_GROUP && _statsRunning)
+                endStats(currentCommandBuffer, _statsCount++);
+            if (_timingMode == QueryMode::PER_GROUP && _timerRunning)
+                endTimer(currentCommandBuffer, _timerCount++);
+            currentCommandBuffer->end();
+        }
 
-        maybe(submitCommands(currentCommandBuffer, currentQueue, waitHandles, signalHandles, true));
+        maybe(submitCommands(currentCommands(), currentQueue, waitHandles, signalHandles, true));
     }
+    maybe(flushSubmits());
 
     if (!async) {
         bool success = false;
@@ -1768,14 +2450,211 @@ auto canta::RenderGraph::run(std::span<SemaphorePair> waits, std::span<Semaphore
         } while (!success);
     }
 
+    addCpuTiming("run", "run", runStart);
+    if (_cpuProfiling) {
+        for (auto &timing : _passCpuTimings) {
+            if (!timing.name.empty())
+                _cpuFrameTimings.push_back(std::move(timing));
+        }
+        {
+            std::scoped_lock lock(_hostCpuTimings->mutex);
+            std::ranges::move(_hostCpuTimings->timings, std::back_inserter(_cpuFrameTimings));
+            _hostCpuTimings->timings.clear();
+        }
+        auto &frame = _cpuTimings[_cpuFrame % CPU_TIMING_FRAMES];
+        std::swap(frame, _cpuFrameTimings);
+        _cpuFrameTimings.clear();
+        _cpuFrame++;
+    }
     return true;
 }
 
-void canta::RenderGraph::reset(const bool keepResources) {
-    if (!keepResources)
-        _resources.clear();
-    Graph::reset();
-}
+auto canta::RenderGraph::buildRecordBatches() const -> std::vector<RecordBatch> {
+    std::vector<RecordBatch> runs = {};
+    u32 queryIndex = 0;
+    for (u32 passIndex = 0; passIndex < _orderedPasses.size(); passIndex++) {
+        const auto &pass = _orderedPasses[passIndex];
+        if (pass._type == RenderPass::Type::HOST || pass._type == RenderPass::Type::PRESENT) {
+            if (!runs.empty() && runs.back().last == passIndex)
+                runs.back().trailingPass = passIndex;
+            continue;
+        }
+        if (runs.empty() || runs.back().last != passIndex || runs.back().queue != pass._queueType) {
+            runs.push_back({
+                .first = passIndex,
+                .last = passIndex,
+                .queue = pass._queueType,
+                .queryIndex = queryIndex,
+            });
+        }
+        runs.back().last = passIndex + 1;
+        queryIndex++;
+    }
+    if (!_parallelRecording)
+        return runs;
+
+    // without async queues everything is one run, so long runs are split across the recording threads and the pieces
+    // submitted back to back in order. short runs stay whole as each batch costs a command buffer
+    // the calling thread records the first batch alongside the pool
+    const u32 threads = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<RecordBatch> batches = {};
+    for (const auto &run : runs) {
+        const u32 passCount = run.last - run.first;
+        const u32 chunks = std::clamp(passCount / MIN_BATCH_PASSES, 1u, threads);
+        const u32 chunkSize = (passCount + chunks - 1) / chunks;
+        for (u32 first = run.first; first < run.last; first += chunkSize) {
+            auto batch = run;
+            batch.first = first;
+            batch.last = std::min(first + chunkSize, run.last);
+            batch.queryIndex = run.queryIndex + first - run.first;
+            batch.trailingPass = batch.last == run.last ? run.trailingPass : -1;
+            batches.push_back(batch);
+        }
+    }
+    return batches;
+}
+
+auto canta::RenderGraph::recordBatch(const RecordBatch &batch, std::span<const VkEvent> events) -> std::expected<bool, RenderGraphError> {
+    auto commands = batch.commands;
+    auto &frameTimers = _timers[_device->flyingIndex()];
+    auto &frameStatistics = _statistics[_device->flyingIndex()];
+    RenderGroup currentGroup = {};
+
+    commands->begin(!_retained);
+    for (u32 passIndex = batch.first; passIndex < batch.last; passIndex++) {
+        const auto &pass = _orderedPasses[passIndex];
+        const auto queryIndex = batch.queryIndex + passIndex - batch.first;
+
+        if (currentGroup.id != pass.group().id) {
+            if (currentGroup.id > -1)
+                commands->popDebugLabel();
+            currentGroup = pass.group();
+            if (currentGroup.id > -1)
+                commands->pushDebugLabel(currentGroup.name, currentGroup.colour);
+        }
+        commands->pushDebugLabel(pass._name, {1, 1, 1, 1});
+
+        if (_timingMode == QueryMode::PER_PASS)
+            frameTimers[queryIndex].timer.begin(*commands, PipelineStage::TOP);
+        if (_statsMode == QueryMode::PER_PASS)
+            frameStatistics[queryIndex].statistics.begin(*commands);
+
+        const auto recordStart = cpuTime();
+        submitBarriers(commands, pass._barriers);
+        for (const auto eventIndex : pass._eventWaits)
+            waitBarriers(commands, events[eventIndex], _eventBarriers[eventIndex].barriers);
+
+        maybe(pass.run(*this, commands));
+
+        for (const auto eventIndex : pass._eventSignals)
+            signalBarriers(commands, events[eventIndex], _eventBarriers[eventIndex].barriers);
+
+        if (_statsMode == QueryMode::PER_PASS)
+            frameStatistics[queryIndex].statistics.end(*commands);
+        if (_timingMode == QueryMode::PER_PASS)
+            frameTimers[queryIndex].timer.end(*commands, PipelineStage::BOTTOM);
+        if (_cpuProfiling)
+            _passCpuTimings[passIndex] = {.category = "record", .name = pass._name, .start = recordStart, .duration = cpuTime() - recordStart, .thread = currentThread()};
+
+        commands->popDebugLabel();
+    }
+    if (batch.trailingPass > -1)
+        submitBarriers(commands, _orderedPasses[batch.trailingPass]._barriers);
+    if (currentGroup.id > -1)
+        commands->popDebugLabel();
+    commands->end();
+    return true;
+}
+
+auto canta::RenderGraph::cpuTimings(const u32 framesAgo) const -> std::span<const CpuTiming> {
+    if (framesAgo >= CPU_TIMING_FRAMES || framesAgo >= _cpuFrame)
+        return {};
+    return _cpuTimings[(_cpuFrame - 1 - framesAgo) % CPU_TIMING_FRAMES];
+}
+
+auto canta::RenderGraph::cpuTime() const -> u64 {
+    if (!_cpuProfiling)
+        return 0;
+    return steadyTime();
+}
+
+void canta::RenderGraph::addCpuTiming(const std::string_view category, const std::string_view name, const u64 start) {
+    if (!_cpuProfiling)
+        return;
+    _cpuFrameTimings.push_back({
+        .category = category,
+        .name = std::string(name),
+        .start = start,
+        .duration = cpuTime() - start,
+        .thread = currentThread(),
+    });
+}
+
+auto canta::RenderGraph::retainedKey() const -> u64 {
+    if (_compiledHash == 0)
+        return 0;
+    const auto combine = [](const u64 hash, const auto value) {
+        return ende::util::combineHash(hash, static_cast<u64>(value));
+    };
+    const auto combineClear = [&combine](const u64 hash, const ClearValue &value) {
+        return std::visit([&](const auto &clear) {
+            return combine(hash, std::hash<std::string_view>()({reinterpret_cast<const char *>(&clear), sizeof(clear)}));
+        },
+                          value);
+    };
+
+    u64 key = combine(_compiledHash, _timingMode);
+    key = combine(key, _statsMode);
+    // batches are split differently when recording in parallel
+    key = combine(key, _parallelRecording);
+    for (const auto &pass : _orderedPasses) {
+        key = combine(key, std::hash<std::string_view>()({reinterpret_cast<const char *>(pass._pushData.data.data()), pass._pushData.size}));
+        // pipelines are recreated in place when shaders reload
+        key = combine(key, pass._pipeline ? reinterpret_cast<u64>(pass._pipeline->pipeline()) : 0);
+        key = combine(key, pass._dimensions.x());
+        key = combine(key, pass._dimensions.y());
+        for (const auto &attachment : pass._renderingColourAttachments)
+            key = combineClear(combine(key, attachment.clearColour.index()), attachment.clearColour);
+        key = combineClear(combine(key, pass._renderingDepthAttachment.clearColour.index()), pass._renderingDepthAttachment.clearColour);
+    }
+    // deferred push constants and attachments resolve to these so a recreated or swapchain resource needs re-recording
+    for (const auto &resource : _resources) {
+        if (std::holds_alternative<BufferInfo>(resource.info)) {
+            const auto &buffer = std::get<BufferInfo>(resource.info).buffer;
+            key = combine(key, buffer ? reinterpret_cast<u64>(buffer->buffer()) : 0);
+        } else {
+            const auto &image = std::get<ImageInfo>(resource.info).image;
+            key = combine(key, image ? reinterpret_cast<u64>(image->image()) : 0);
+        }
+    }
+    return key == 0 ? 1 : key;
+}
+
+void canta::RenderGraph::reset(const bool keepResources) {
+    if (!keepResources) {
+        for (auto &resource : _resources)
+            releaseResource(resource);
+        _resources.clear();
+    }
+    // the passes storage is handed to the next build instead of being freed. pooled in reverse so newPass() hands
+    // each pass the storage of the pass built in the same place last time, which already has the capacity it needs
+    for (i32 vertexIndex = static_cast<i32>(vertexCount()) - 1; vertexIndex >= 0; vertexIndex--)
+        _passPool.emplace_back().reuseStorage(getVertices()[vertexIndex]);
+    *_passAllocations = 0;
+    Graph::reset();
+    _cpuBuildStart = cpuTime();
+}
+
+auto canta::RenderGraph::newPass() -> RenderPass & {
+    auto &pass = addVertex();
+    if (_passPool.empty()) {
+        pass.setAllocationCounter(_passAllocations.get());
+        return pass;
+    }
+    pass.reuseStorage(_passPool.back());
+    _passPool.pop_back();
+    return pass;
+}
 
 auto canta::RenderGraph::getResourceIndices(const std::span<const RenderPass> passes) const -> std::vector<std::pair<u32, u32>> {
     std::vector<std::pair<u32, u32>> indices = {};
@@ -1816,10 +2695,135 @@ auto canta::RenderGraph::buildDependencyLevels(std::span<const RenderPass> passe
     return levels;
 }
 
+inline auto passCostKey(const i32 vertexIndex, const std::string_view name) -> u64 {
+    return ende::util::combineHash(static_cast<u64>(vertexIndex), std::hash<std::string_view>()(name));
+}
+
+void canta::RenderGraph::updatePassCosts() {
+    if (_timingMode != QueryMode::PER_PASS)
+        return;
+    for (auto &timer : timers()) {
+        if (timer.pass < 0)
+            continue;
+        const auto time = timer.timer.result();
+        if (!time || *time == 0)
+            continue;
+        // only keep costs that moved by more than a quarter so timing noise doesnt recompile every frame
+        auto &cost = _passCosts[passCostKey(timer.pass, timer.name)];
+        if (cost == 0 || *time > cost + cost / 4 || *time < cost - cost / 4) {
+            cost = *time;
+            _costEpoch++;
+        }
+    }
+}
+
+void canta::RenderGraph::scheduleAsyncCompute(std::span<RenderPass> passes, std::span<const std::vector<u32>> levels) const {
+    // rough cost in nanoseconds of the semaphore wait added when work moves to another queue
+    constexpr u64 queueSyncCost = 10000;
+
+    if (!_device->queueEnabled(QueueType::COMPUTE))
+        return;
+
+    // passes without a hint or measurement cost the average of the known ones. with nothing known the level heuristic stays
+    std::vector<u64> costs(passes.size(), 0);
+    u64 knownCost = 0;
+    u32 knownCount = 0;
+    for (u32 passIndex = 0; passIndex < passes.size(); passIndex++) {
+        const auto &pass = passes[passIndex];
+        if (pass._costHint > 0)
+            costs[passIndex] = pass._costHint;
+        else if (const auto it = _passCosts.find(passCostKey(pass._vertexIndex, pass._name)); it != _passCosts.end())
+            costs[passIndex] = it->second;
+        if (costs[passIndex] > 0) {
+            knownCost += costs[passIndex];
+            knownCount++;
+        }
+    }
+    if (knownCount == 0)
+        return;
+    const u64 defaultCost = knownCost / knownCount;
+    for (u32 passIndex = 0; passIndex < passes.size(); passIndex++) {
+        if (costs[passIndex] == 0)
+            costs[passIndex] = defaultCost;
+        // rebalanced from scratch below
+        if (passes[passIndex]._type == RenderPass::Type::COMPUTE && passes[passIndex]._queueType == QueueType::COMPUTE)
+            passes[passIndex]._queueType = QueueType::GRAPHICS;
+    }
+
+    std::unordered_map<i32, u32> producers = {};
+    for (u32 passIndex = 0; passIndex < passes.size(); passIndex++) {
+        for (const auto &output : passes[passIndex].outputs)
+            std::visit([&](const auto &index) { producers[index.id] = passIndex; }, output);
+    }
+    std::vector<std::vector<u32>> predecessors(passes.size());
+    for (u32 passIndex = 0; passIndex < passes.size(); passIndex++) {
+        for (const auto &input : passes[passIndex].inputs) {
+            std::visit([&](const auto &index) {
+                if (const auto it = producers.find(index.id); it != producers.end() && it->second != passIndex)
+                    predecessors[passIndex].push_back(it->second);
+            },
+                       input);
+        }
+    }
+
+    // passes are topologically sorted so one forward walk gives the weighted finish time of each pass
+    std::vector<u64> finish(passes.size(), 0);
+    for (u32 passIndex = 0; passIndex < passes.size(); passIndex++) {
+        u64 start = 0;
+        for (const auto predecessor : predecessors[passIndex])
+            start = std::max(start, finish[predecessor]);
+        finish[passIndex] = start + costs[passIndex];
+    }
+
+    // walk back from the latest finishing pass to find the critical path. it stays on the graphics queue
+    std::vector<bool> critical(passes.size(), false);
+    if (!passes.empty()) {
+        i32 current = std::distance(finish.begin(), std::max_element(finish.begin(), finish.end()));
+        while (current > -1) {
+            critical[current] = true;
+            i32 next = -1;
+            for (const auto predecessor : predecessors[current]) {
+                if (next < 0 || finish[predecessor] > finish[next])
+                    next = predecessor;
+            }
+            current = next;
+        }
+    }
+
+    // passes in a level are independent so balance the load of each level across both queues
+    for (const auto &level : levels) {
+        u64 graphicsLoad = 0;
+        u64 computeLoad = 0;
+        std::vector<u32> candidates = {};
+        for (const auto passIndex : level) {
+            const auto &pass = passes[passIndex];
+            if (pass._queueType == QueueType::GRAPHICS)
+                graphicsLoad += costs[passIndex];
+            else if (pass._queueType == QueueType::COMPUTE)
+                computeLoad += costs[passIndex];
+            if (pass._type == RenderPass::Type::COMPUTE && pass._queueType == QueueType::GRAPHICS && !critical[passIndex])
+                candidates.push_back(passIndex);
+        }
+        std::ranges::sort(candidates, std::greater{}, [&](const u32 passIndex) { return costs[passIndex]; });
+
+        for (const auto passIndex : candidates) {
+            const auto cost = costs[passIndex];
+            const auto before = std::max(graphicsLoad, computeLoad);
+            const auto after = std::max(graphicsLoad - cost, computeLoad + cost + queueSyncCost);
+            if (after >= before)
+                continue;
+            passes[passIndex]._queueType = QueueType::COMPUTE;
+            graphicsLoad -= cost;
+            computeLoad += cost;
+        }
+    }
+}
+
+// handle can stand in for a resource described by info. usage may be a superset as the device adds its own flags
 auto compareBuffer(const canta::BufferInfo &info, canta::BufferHandle handle) -> bool {
     return info.size == handle->size() &&
            info.type == handle->type() &&
-           (info.usage & handle->usage()) == handle->usage();
+           (handle->usage() & info.usage) == info.usage;
 }
 
 auto compareImage(const canta::ImageInfo &info, canta::ImageHandle handle) -> bool {
@@ -1828,44 +2832,54 @@ auto compareImage(const canta::ImageInfo &info, canta::ImageHandle handle) -> bo
            info.depth == handle->depth() &&
            info.mips == handle->mips() &&
            info.format == handle->format() &&
-           (info.usage & handle->usage()) == handle->usage();
+           (handle->usage() & info.usage) == info.usage;
+}
+
+// usage is left out of pool keys so superset matches land in the same bucket
+auto bufferPoolKey(const u32 size, const canta::MemoryType type) -> u64 {
+    return ende::util::combineHash(static_cast<u64>(size), static_cast<u64>(type));
+}
+
+auto imagePoolKey(const u32 width, const u32 height, const u32 depth, const u32 mips, const canta::Format format) -> u64 {
+    u64 hash = ende::util::combineHash(static_cast<u64>(width), static_cast<u64>(height));
+    hash = ende::util::combineHash(hash, static_cast<u64>(depth));
+    hash = ende::util::combineHash(hash, static_cast<u64>(mips));
+    return ende::util::combineHash(hash, static_cast<u64>(format));
 }
 
 auto canta::RenderGraph::getNextAccess(const i32 startIndex, const i32 resource) -> Access {
-    for (i32 passIndex = startIndex + 1; passIndex < _orderedPasses.size(); passIndex++) {
-        const auto &pass = _orderedPasses[passIndex];
+    if (resource >= _resourceAccesses.size())
+        return {-1, {}};
 
-        for (auto &access : pass._accesses) {
-            if (access.index == resource)
-                return {passIndex, access};
-        }
-    }
+    const auto &accesses = _resourceAccesses[resource];
+    const auto it = std::ranges::upper_bound(accesses, startIndex, std::less{}, &Access::passIndex);
+    if (it != accesses.end())
+        return *it;
     return {-1, {}};
 }
 
 auto canta::RenderGraph::getCurrAccess(const i32 startIndex, const i32 resource) -> Access {
-    const auto &pass = _orderedPasses[startIndex];
+    if (resource >= _resourceAccesses.size())
+        return {-1, {}};
 
-    for (auto &access : pass._accesses) {
-        if (access.index == resource)
-            return {startIndex, access};
-    }
+    const auto &accesses = _resourceAccesses[resource];
+    const auto it = std::ranges::lower_bound(accesses, startIndex, std::less{}, &Access::passIndex);
+    if (it != accesses.end() && it->passIndex == startIndex)
+        return *it;
     return {-1, {}};
 }
 
 auto canta::RenderGraph::getPrevAccess(const i32 startIndex, const i32 resource) -> Access {
-    for (i32 passIndex = startIndex - 1; passIndex >= 0; passIndex--) {
-        const auto &pass = _orderedPasses[passIndex];
-
-        for (auto &access : pass._accesses) {
-            if (access.index == resource)
-                return {passIndex, access};
-        }
+    if (resource < _resourceAccesses.size()) {
+        const auto &accesses = _resourceAccesses[resource];
+        const auto it = std::ranges::lower_bound(accesses, startIndex, std::less{}, &Access::passIndex);
+        if (it != accesses.begin())
+            return *std::prev(it);
     }
-    return {-1, _resources[resource].initialAccess};
+    return {-1, _resources[resource].aliasedAccess.value_or(_resources[resource].initialAccess)};
 }
 
-void canta::RenderGraph::submitBarriers(CommandHandle commands, std::span<const RenderPass::Barrier> barriers) const {
+void canta::RenderGraph::convertBarriers(std::span<const RenderPass::Barrier> barriers, const std::function<void(std::span<const ImageBarrier>, std::span<const BufferBarrier>)> &func) const {
     u32 imageBarrierCount = 0;
     ImageBarrier imageBarriers[barriers.size()];
     u32 bufferBarrierCount = 0;
@@ -1882,6 +2896,8 @@ void canta::RenderGraph::submitBarriers(CommandHandle commands, std::span<const
                 .dstStage = barrier.dstStage,
                 .srcAccess = barrier.srcAccess,
                 .dstAccess = barrier.dstAccess,
+                .offset = barrier.range.offset,
+                .size = barrier.range.size,
             };
         } else {
             const auto imageInfo = std::get<ImageInfo>(resource.info);
@@ -1898,17 +2914,41 @@ void canta::RenderGraph::submitBarriers(CommandHandle commands, std::span<const
                 .dstAccess = barrier.dstAccess,
                 .srcLayout = barrier.srcLayout,
                 .dstLayout = barrier.dstLayout,
+                .layer = barrier.subresource.layer,
+                .layerCount = barrier.subresource.layerCount,
+                .mip = barrier.subresource.mip,
+                .mipCount = barrier.subresource.mipCount,
             };
         }
     }
 
-    for (u32 barrier = 0; barrier < imageBarrierCount; barrier++)
-        commands->barrier(imageBarriers[barrier]);
-    for (u32 barrier = 0; barrier < bufferBarrierCount; barrier++)
-        commands->barrier(bufferBarriers[barrier]);
+    func(std::span(imageBarriers, imageBarrierCount), std::span(bufferBarriers, bufferBarrierCount));
+}
+
+void canta::RenderGraph::submitBarriers(CommandHandle commands, std::span<const RenderPass::Barrier> barriers) const {
+    convertBarriers(barriers, [&commands](std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers) {
+        commands->barriers(imageBarriers, bufferBarriers);
+    });
+}
+
+void canta::RenderGraph::signalBarriers(CommandHandle commands, VkEvent event, std::span<const RenderPass::Barrier> barriers) const {
+    convertBarriers(barriers, [&commands, event](std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers) {
+        commands->setEvent(event, imageBarriers, bufferBarriers);
+    });
+}
+
+void canta::RenderGraph::waitBarriers(CommandHandle commands, VkEvent event, std::span<const RenderPass::Barrier> barriers) const {
+    convertBarriers(barriers, [&commands, event](std::span<const ImageBarrier> imageBarriers, std::span<const BufferBarrier> bufferBarriers) {
+        commands->waitEvent(event, imageBarriers, bufferBarriers);
+    });
+
+    auto stages = PipelineStage::NONE;
+    for (const auto &barrier : barriers)
+        stages |= barrier.dstStage;
+    commands->resetEvent(event, stages);
 }
 
-void canta::RenderGraph::startTimer(CommandHandle commands, const u32 index, const std::string_view name, const QueueType queue) {
+void canta::RenderGraph::startTimer(CommandHandle commands, const u32 index, const std::string_view name, const QueueType queue, const i32 pass) {
     auto &frameTimers = _timers[_device->flyingIndex()];
     while (frameTimers.size() <= index)
         frameTimers.emplace_back(TimerInfo{{}, QueueType::NONE, _device->createTimer()});
@@ -1916,6 +2956,7 @@ void canta::RenderGraph::startTimer(CommandHandle commands, const u32 index, con
     auto &timer = frameTimers[index];
     timer.name = name;
     timer.queue = queue;
+    timer.pass = pass;
     timer.timer.begin(*commands, PipelineStage::TOP);
     _timerRunning = true;
 }
@@ -1946,70 +2987,191 @@ void canta::RenderGraph::endStats(CommandHandle commands, const u32 index) {
     _statsRunning = false;
 }
 
+void canta::RenderGraph::buildAccessTimelines() {
+    _resourceAccesses.resize(_resources.size());
+    for (auto &accesses : _resourceAccesses)
+        accesses.clear();
+
+    for (i32 passIndex = 0; passIndex < _orderedPasses.size(); passIndex++) {
+        for (const auto &access : _orderedPasses[passIndex]._accesses)
+            _resourceAccesses[access.index].push_back({passIndex, access});
+    }
+}
+
 void canta::RenderGraph::buildBarriers() {
-    for (auto &pass : _orderedPasses)
-        pass.mergeAccesses();
+    // last access of each disjoint subresource or byte range region of a resource and the barrier that made it visible.
+    // resources only accessed as a whole keep a single region
+    struct Region {
+        SubresourceBounds bounds = {};
+        Access access = {};
+        i32 barrierPass = -1;
+        i32 barrierIndex = -1;
+    };
+    // open ended accesses are clamped to the resource so no region ever covers mips, layers or bytes that dont exist
+    std::vector<SubresourceBounds> limits(_resources.size());
+    std::vector<std::vector<Region>> regions(_resources.size());
+    for (u32 resource = 0; resource < _resources.size(); resource++) {
+        limits[resource] = resourceBounds(_resources[resource].info);
+        regions[resource].push_back({.bounds = limits[resource], .access = {-1, _resources[resource].aliasedAccess.value_or(_resources[resource].initialAccess)}});
+    }
+    _elidedBarriers = 0;
 
-    for (i32 passIndex = _orderedPasses.size() - 1; passIndex >= 0; passIndex--) {
+    const auto canElide = [this](const Access &prevAccess, const Access &currAccess) {
+        if (prevAccess.passIndex < 0)
+            return false;
+        const auto &prevPass = _orderedPasses[prevAccess.passIndex];
+        const auto &currPass = _orderedPasses[currAccess.passIndex];
+        if (prevPass._queueType != currPass._queueType)
+            return false;
+        if (prevPass._type == RenderPass::Type::PRESENT || prevPass._type == RenderPass::Type::HOST ||
+            currPass._type == RenderPass::Type::PRESENT || currPass._type == RenderPass::Type::HOST)
+            return false;
+        return !hasWriteAccess(prevAccess.access.access) && !hasWriteAccess(currAccess.access.access) &&
+               prevAccess.access.layout == currAccess.access.layout;
+    };
+
+    std::vector<Region> updated = {};
+    for (i32 passIndex = 0; passIndex < _orderedPasses.size(); passIndex++) {
         auto &pass = _orderedPasses[passIndex];
 
         for (auto &access : pass._accesses) {
             i32 resource = access.index;
+            const auto currAccess = Access{passIndex, access};
+            const auto bounds = intersection(toBounds(access), limits[resource]);
+            if (empty(bounds))
+                continue;
 
-            const auto currAccess = getCurrAccess(passIndex, resource);
-            const auto prevAccess = getPrevAccess(passIndex, resource);
-
-            auto barrier = RenderPass::Barrier{
-                .index = resource,
-                .passIndex = passIndex,
-                .srcStage = prevAccess.access.stage,
-                .dstStage = currAccess.access.stage,
-                .srcAccess = prevAccess.access.access,
-                .dstAccess = currAccess.access.access,
-                .srcLayout = prevAccess.access.layout,
-                .dstLayout = currAccess.access.layout,
-            };
-            pass._barriers.emplace_back(barrier);
+            updated.clear();
+            for (const auto &region : regions[resource]) {
+                if (!overlaps(region.bounds, bounds)) {
+                    updated.push_back(region);
+                    continue;
+                }
+                subtract(region.bounds, bounds, [&](const SubresourceBounds &remaining) {
+                    updated.push_back({remaining, region.access, region.barrierPass, region.barrierIndex});
+                });
+                const auto overlap = intersection(region.bounds, bounds);
+                const auto &prevAccess = region.access;
+
+                if (prevAccess.passIndex > -1) {
+                    auto &prevPass = _orderedPasses[prevAccess.passIndex];
+                    const auto addWait = [&](const QueueType queue) {
+                        if (std::ranges::find(pass._queueWaits, std::make_pair(prevAccess.passIndex, queue)) == pass._queueWaits.end())
+                            pass._queueWaits.emplace_back(prevAccess.passIndex, queue);
+                    };
+                    if (prevPass._queueType != pass._queueType || pass._type == RenderPass::Type::PRESENT)
+                        addWait(prevPass._queueType);
+                    if (prevPass._type == RenderPass::Type::PRESENT)
+                        addWait(QueueType::NONE);
+                }
 
-            if (prevAccess.passIndex > -1) {
-                auto &prevPass = _orderedPasses[prevAccess.passIndex];
-                if (prevPass._queueType != pass._queueType || pass._type == RenderPass::Type::PRESENT) {
-                    pass._queueWaits.emplace_back(prevAccess.passIndex, prevPass._queueType);
+                // read after read in the same layout only needs the barrier which made the last write visible to also cover this access
+                if (region.barrierPass > -1 && canElide(prevAccess, currAccess)) {
+                    auto &target = _orderedPasses[region.barrierPass]._barriers[region.barrierIndex];
+                    if (target.dstLayout == access.layout && _orderedPasses[region.barrierPass]._queueType == pass._queueType) {
+                        target.dstStage |= access.stage;
+                        target.dstAccess |= access.access;
+                        _elidedBarriers++;
+                        updated.push_back({overlap, currAccess, region.barrierPass, region.barrierIndex});
+                        continue;
+                    }
                 }
-                if (prevPass._type == RenderPass::Type::PRESENT)
-                    pass._queueWaits.emplace_back(prevAccess.passIndex, QueueType::NONE);
+
+                auto barrier = RenderPass::Barrier{
+                    .index = resource,
+                    .passIndex = passIndex,
+                    .prevPassIndex = prevAccess.passIndex,
+                    .srcStage = prevAccess.access.stage,
+                    .dstStage = access.stage,
+                    .srcAccess = prevAccess.access.access,
+                    .dstAccess = access.access,
+                    .srcLayout = prevAccess.access.layout,
+                    .dstLayout = access.layout,
+                    .subresource = toSubresource(overlap),
+                    .range = toRange(overlap),
+                };
+                updated.push_back({overlap, currAccess, passIndex, static_cast<i32>(pass._barriers.size())});
+                pass._barriers.emplace_back(barrier);
             }
+            std::swap(regions[resource], updated);
         }
     }
 }
 
+void canta::RenderGraph::buildSplitBarriers() {
+    _eventBarriers.clear();
+    if (!_splitBarriers)
+        return;
+
+    const auto isHostOrPresent = [](const RenderPass &pass) {
+        return pass._type == RenderPass::Type::HOST || pass._type == RenderPass::Type::PRESENT;
+    };
+
+    // passes recorded into the same command buffer share a segment. events only work within a queue so only split within a segment
+    std::vector<u32> segments(_orderedPasses.size(), 0);
+    for (u32 passIndex = 1; passIndex < _orderedPasses.size(); passIndex++) {
+        const auto &prevPass = _orderedPasses[passIndex - 1];
+        const auto &pass = _orderedPasses[passIndex];
+        const bool boundary = prevPass._queueType != pass._queueType || isHostOrPresent(prevPass) || isHostOrPresent(pass);
+        segments[passIndex] = segments[passIndex - 1] + (boundary ? 1 : 0);
+    }
+
+    for (i32 passIndex = 0; passIndex < _orderedPasses.size(); passIndex++) {
+        auto &pass = _orderedPasses[passIndex];
+        if (isHostOrPresent(pass))
+            continue;
+
+        PassVector<RenderPass::Barrier> barriers(pass._barriers.get_allocator());
+        for (const auto &barrier : pass._barriers) {
+            // adjacent passes gain nothing from splitting
+            const auto signalPass = barrier.prevPassIndex;
+            if (signalPass < 0 || signalPass >= passIndex - 1 || segments[signalPass] != segments[passIndex]) {
+                barriers.push_back(barrier);
+                continue;
+            }
+
+            // one event per producer consumer pair
+            auto it = std::ranges::find_if(pass._eventWaits, [&](const u32 eventIndex) {
+                return _eventBarriers[eventIndex].signalPass == signalPass;
+            });
+            u32 eventIndex = 0;
+            if (it != pass._eventWaits.end()) {
+                eventIndex = *it;
+            } else {
+                eventIndex = _eventBarriers.size();
+                _eventBarriers.push_back({
+                    .signalPass = signalPass,
+                    .waitPass = passIndex,
+                });
+                pass._eventWaits.push_back(eventIndex);
+                _orderedPasses[signalPass]._eventSignals.push_back(eventIndex);
+            }
+            _eventBarriers[eventIndex].barriers.push_back(barrier);
+        }
+        pass._barriers = std::move(barriers);
+    }
+}
+
 void canta::RenderGraph::buildResources() {
-    // TODO: allocate and alias in memory pool
-
-    // const auto sizes = std::views::transform(_resources, [](auto& resource) {
-    //     if (std::holds_alternative<BufferInfo>(resource)) {
-    //         return std::get<BufferInfo>(resource).size;
-    //     } else {
-    //         auto& info = std::get<ImageInfo>(resource);
-    //         return info.width * info.height * info.depth * formatSize(info.format);
-    //     }
-    // });
-    //
-    // const auto size = std::accumulate(sizes.begin(), sizes.end(), 0);
-    // if (size > _poolSize) {
-    //
-    //     VmaPoolCreateInfo createInfo = {};
-    //     createInfo.blockSize = size;
-    //     createInfo.maxBlockCount = 2;
-    //
-    //
-    //
-    //     _poolSize = size;
-    // }
+    _transientMemory = 0;
+    _naiveTransientMemory = 0;
+    for (auto &resource : _resources)
+        resource.aliasedAccess = std::nullopt;
+    if (_transientAliasing) {
+        buildTransientResources();
+    } else {
+        for (auto &aliased : _aliasedResources)
+            aliased.clear();
+    }
 
     for (auto &resource : _resources) {
         if (std::holds_alternative<BufferInfo>(resource.info)) {
             auto &bufferInfo = std::get<BufferInfo>(resource.info);
+            if (bufferInfo.external || (bufferInfo.buffer && compareBuffer(bufferInfo, bufferInfo.buffer)))
+                continue;
+            releaseResource(resource);
+
+            bufferInfo.buffer = acquireBuffer(bufferInfo);
             if (bufferInfo.buffer)
                 continue;
 
@@ -2024,7 +3186,12 @@ void canta::RenderGraph::buildResources() {
 
         } else {
             auto &imageInfo = std::get<ImageInfo>(resource.info);
-            if (imageInfo.swapchainImage || (imageInfo.image && compareImage(imageInfo, imageInfo.image)))
+            if (imageInfo.external || imageInfo.swapchainImage || (imageInfo.image && compareImage(imageInfo, imageInfo.image)))
+                continue;
+            releaseResource(resource);
+
+            imageInfo.image = acquireImage(imageInfo);
+            if (imageInfo.image)
                 continue;
 
             const auto image = _device->createImage({
@@ -2040,11 +3207,357 @@ void canta::RenderGraph::buildResources() {
             imageInfo.image = image;
         }
     }
+
+    // anything not picked up for another FRAMES_IN_FLIGHT frames after becoming available is no longer part of the graph
+    const auto expired = [frame = _device->frameValue()](const auto &entry) {
+        return entry.second.frame + 2 * FRAMES_IN_FLIGHT <= frame;
+    };
+    std::erase_if(_bufferPool, expired);
+    std::erase_if(_imagePool, expired);
+}
+
+void canta::RenderGraph::releaseResource(Resource &resource) {
+    // aliased resources are tied to this frames transient heap so are never pooled
+    if (auto *bufferInfo = std::get_if<BufferInfo>(&resource.info)) {
+        if (bufferInfo->external || !bufferInfo->buffer)
+            return;
+        const auto buffer = std::exchange(bufferInfo->buffer, {});
+        if (!buffer->aliased())
+            _bufferPool.emplace(bufferPoolKey(buffer->size(), buffer->type()), PooledResource<BufferHandle>{buffer, _lastRunFrame});
+    } else {
+        auto &imageInfo = std::get<ImageInfo>(resource.info);
+        if (imageInfo.external || imageInfo.swapchainImage || !imageInfo.image)
+            return;
+        const auto image = std::exchange(imageInfo.image, {});
+        if (!image->aliased())
+            _imagePool.emplace(imagePoolKey(image->width(), image->height(), image->depth(), image->mips(), image->format()), PooledResource<ImageHandle>{image, _lastRunFrame});
+    }
+}
+
+auto canta::RenderGraph::acquireBuffer(const BufferInfo &info) -> BufferHandle {
+    auto [first, last] = _bufferPool.equal_range(bufferPoolKey(info.size, info.type));
+    for (auto it = first; it != last; it++) {
+        if (it->second.frame + FRAMES_IN_FLIGHT > _device->frameValue() || !compareBuffer(info, it->second.handle))
+            continue;
+        auto buffer = it->second.handle;
+        _bufferPool.erase(it);
+        return buffer;
+    }
+    return {};
+}
+
+auto canta::RenderGraph::acquireImage(const ImageInfo &info) -> ImageHandle {
+    auto [first, last] = _imagePool.equal_range(imagePoolKey(info.width, info.height, info.depth, info.mips, info.format));
+    for (auto it = first; it != last; it++) {
+        if (it->second.frame + FRAMES_IN_FLIGHT > _device->frameValue() || !compareImage(info, it->second.handle))
+            continue;
+        auto image = it->second.handle;
+        _imagePool.erase(it);
+        return image;
+    }
+    return {};
+}
+
+void canta::RenderGraph::buildTransientResources() {
+    struct Placement {
+        u32 resource = 0;
+        u32 heap = 0;
+        u32 first = 0;
+        u32 last = 0;
+        VkMemoryRequirements requirements = {};
+        u64 offset = 0;
+        bool placed = false;
+    };
+
+    const auto lifetimes = getResourceIndices(_orderedPasses);
+
+    // lifetimes are in pass order which only orders passes on the same queue, anything used off the graphics queue
+    // could run alongside a resource sharing its memory so is left out
+    std::vector<bool> crossQueue(_resources.size(), false);
+    for (const auto &pass : _orderedPasses) {
+        if (pass._queueType == QueueType::GRAPHICS)
+            continue;
+        for (const auto &access : pass._accesses) {
+            if (access.index >= 0 && access.index < crossQueue.size())
+                crossQueue[access.index] = true;
+        }
+    }
+
+    std::vector<Placement> placements = {};
+    for (u32 index = 0; index < _resources.size(); index++) {
+        const auto &resource = _resources[index];
+        const auto [first, last] = lifetimes[index];
+        if (first > last || crossQueue[index])
+            continue;
+
+        if (std::holds_alternative<BufferInfo>(resource.info)) {
+            const auto &bufferInfo = std::get<BufferInfo>(resource.info);
+            if (bufferInfo.external || bufferInfo.type != MemoryType::DEVICE)
+                continue;
+
+            placements.push_back({
+                .resource = index,
+                .heap = 0,
+                .first = first,
+                .last = last,
+                .requirements = _device->memoryRequirements(Buffer::CreateInfo{
+                    .size = bufferInfo.size,
+                    .usage = bufferInfo.usage,
+                    .type = bufferInfo.type,
+                }),
+            });
+        } else {
+            const auto &imageInfo = std::get<ImageInfo>(resource.info);
+            if (imageInfo.external || imageInfo.swapchainImage)
+                continue;
+
+            placements.push_back({
+                .resource = index,
+                .heap = 1,
+                .first = first,
+                .last = last,
+                .requirements = _device->memoryRequirements(Image::CreateInfo{
+                    .width = imageInfo.width,
+                    .height = imageInfo.height,
+                    .depth = imageInfo.depth,
+                    .format = imageInfo.format,
+                    .mipLevels = imageInfo.mips,
+                    .usage = imageInfo.usage,
+                }),
+            });
+        }
+    }
+
+    if (placements.empty()) {
+        _aliasedResources[_device->flyingIndex()].clear();
+        return;
+    }
+
+    const auto lifetimesOverlap = [](const Placement &lhs, const Placement &rhs) {
+        return lhs.first <= rhs.last && rhs.first <= lhs.last;
+    };
+    const auto alignUp = [](const u64 value, const u64 alignment) {
+        return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+    };
+
+    // largest first, each resource takes the lowest offset not used by a resource alive at the same time
+    std::ranges::sort(placements, std::greater{}, [](const Placement &placement) { return placement.requirements.size; });
+
+    std::array<u64, 2> heapSizes = {};
+    std::array<u64, 2> heapAlignments = {1, 1};
+    std::array<u32, 2> heapTypeBits = {~0u, ~0u};
+    std::vector<const Placement *> overlapping = {};
+    for (auto &placement : placements) {
+        if ((heapTypeBits[placement.heap] & placement.requirements.memoryTypeBits) == 0)
+            continue;
+
+        overlapping.clear();
+        for (const auto &other : placements) {
+            if (other.placed && other.heap == placement.heap && lifetimesOverlap(placement, other))
+                overlapping.push_back(&other);
+        }
+        std::ranges::sort(overlapping, std::less{}, [](const Placement *other) { return other->offset; });
+
+        u64 offset = 0;
+        for (const auto *other : overlapping) {
+            if (alignUp(offset, placement.requirements.alignment) + placement.requirements.size <= other->offset)
+                break;
+            offset = std::max(offset, other->offset + other->requirements.size);
+        }
+        placement.offset = alignUp(offset, placement.requirements.alignment);
+        placement.placed = true;
+
+        heapSizes[placement.heap] = std::max(heapSizes[placement.heap], placement.offset + placement.requirements.size);
+        heapAlignments[placement.heap] = std::max(heapAlignments[placement.heap], placement.requirements.alignment);
+        heapTypeBits[placement.heap] &= placement.requirements.memoryTypeBits;
+    }
+
+    // previous heap for this frame index is no longer in flight so can be replaced immediately
+    const u32 frameIndex = _device->flyingIndex();
+    auto &heaps = _transientHeaps[frameIndex];
+    for (u32 heapIndex = 0; heapIndex < heaps.size(); heapIndex++) {
+        auto &heap = heaps[heapIndex];
+        if (heapSizes[heapIndex] == 0)
+            continue;
+        if (heap.memory && heap.size >= heapSizes[heapIndex] && (heapTypeBits[heapIndex] & (1u << heap.memoryType)) != 0)
+            continue;
+
+        heap = {};
+        const auto allocation = _device->allocateMemory({
+            .size = heapSizes[heapIndex],
+            .alignment = heapAlignments[heapIndex],
+            .memoryTypeBits = heapTypeBits[heapIndex],
+        });
+        if (!allocation) {
+            _device->logger().warn("Failed to allocate transient memory for graph {}", _name);
+            for (auto &placement : placements) {
+                if (placement.heap == heapIndex)
+                    placement.placed = false;
+            }
+            continue;
+        }
+
+        VmaAllocationInfo allocationInfo = {};
+        vmaGetAllocationInfo(_device->allocator(), *allocation, &allocationInfo);
+
+        heap.memory = std::shared_ptr<VmaAllocation_T>(*allocation, [device = _device](VmaAllocation memory) {
+            device->freeMemory(memory);
+        });
+        heap.size = heapSizes[heapIndex];
+        heap.memoryType = allocationInfo.memoryType;
+    }
+
+    // handles from the last time this frame index compiled stay valid while nothing about them has changed, so the graph
+    // keeps the same handles and bindless indices from frame to frame
+    auto previous = std::move(_aliasedResources[frameIndex]);
+    auto &aliased = _aliasedResources[frameIndex];
+    aliased.clear();
+    const auto takePrevious = [&](const VmaAllocation memory, const u64 offset, const auto &matches) -> std::optional<AliasedResource> {
+        for (auto it = previous.begin(); it != previous.end(); it++) {
+            if (it->memory != memory || it->offset != offset || !matches(*it))
+                continue;
+            auto entry = std::move(*it);
+            *it = std::move(previous.back());
+            previous.pop_back();
+            return entry;
+        }
+        return std::nullopt;
+    };
+
+    for (const auto &placement : placements) {
+        auto &resource = _resources[placement.resource];
+        if (!placement.placed) {
+            // drop stale aliased handles so they get allocated normally
+            if (auto *bufferInfo = std::get_if<BufferInfo>(&resource.info); bufferInfo && bufferInfo->buffer && bufferInfo->buffer->aliased())
+                bufferInfo->buffer = {};
+            if (auto *imageInfo = std::get_if<ImageInfo>(&resource.info); imageInfo && imageInfo->image && imageInfo->image->aliased())
+                imageInfo->image = {};
+            continue;
+        }
+
+        _naiveTransientMemory += placement.requirements.size;
+        releaseResource(resource);
+
+        const auto memory = heaps[placement.heap].memory.get();
+        if (std::holds_alternative<BufferInfo>(resource.info)) {
+            auto &bufferInfo = std::get<BufferInfo>(resource.info);
+            auto entry = takePrevious(memory, placement.offset, [&](const AliasedResource &entry) {
+                return entry.buffer && compareBuffer(bufferInfo, entry.buffer) && entry.buffer->usage() == bufferInfo.usage;
+            });
+            if (!entry) {
+                entry = AliasedResource{
+                    .memory = memory,
+                    .offset = placement.offset,
+                    .buffer = _device->createBuffer({
+                        .size = bufferInfo.size,
+                        .usage = bufferInfo.usage,
+                        .type = bufferInfo.type,
+                        .name = bufferInfo.name,
+                        .aliasAllocation = memory,
+                        .aliasOffset = placement.offset,
+                    }),
+                };
+            }
+            bufferInfo.buffer = entry->buffer;
+            aliased.push_back(std::move(*entry));
+        } else {
+            auto &imageInfo = std::get<ImageInfo>(resource.info);
+            auto entry = takePrevious(memory, placement.offset, [&](const AliasedResource &entry) {
+                return entry.image && compareImage(imageInfo, entry.image) && entry.image->usage() == imageInfo.usage;
+            });
+            if (!entry) {
+                entry = AliasedResource{
+                    .memory = memory,
+                    .offset = placement.offset,
+                    .image = _device->createImage({
+                        .width = imageInfo.width,
+                        .height = imageInfo.height,
+                        .depth = imageInfo.depth,
+                        .format = imageInfo.format,
+                        .mipLevels = imageInfo.mips,
+                        .usage = imageInfo.usage,
+                        .name = imageInfo.name,
+                        .aliasAllocation = memory,
+                        .aliasOffset = placement.offset,
+                    }),
+                };
+            }
+            imageInfo.image = entry->image;
+            aliased.push_back(std::move(*entry));
+        }
+
+        // first barrier of an aliased resource must wait on the last use of anything previously in its memory
+        ResourceAccess initialAccess = resource.initialAccess;
+        initialAccess.access = canta::Access::NONE;
+        initialAccess.stage = PipelineStage::NONE;
+        initialAccess.layout = ImageLayout::UNDEFINED;
+        for (const auto &other : placements) {
+            if (!other.placed || other.heap != placement.heap || other.last >= placement.first)
+                continue;
+            if (other.offset >= placement.offset + placement.requirements.size || placement.offset >= other.offset + other.requirements.size)
+                continue;
+
+            for (const auto &access : _orderedPasses[other.last]._accesses) {
+                if (access.index != other.resource)
+                    continue;
+                initialAccess.access |= access.access;
+                initialAccess.stage |= access.stage;
+            }
+        }
+        if (initialAccess.stage == PipelineStage::NONE) {
+            initialAccess.access = canta::Access::MEMORY_READ | canta::Access::MEMORY_WRITE;
+            initialAccess.stage = PipelineStage::TOP;
+        }
+        resource.aliasedAccess = initialAccess;
+    }
+
+    for (u32 heapIndex = 0; heapIndex < heapSizes.size(); heapIndex++) {
+        if (heaps[heapIndex].memory)
+            _transientMemory += heapSizes[heapIndex];
+    }
 }
 
 auto canta::RenderGraph::buildRenderAttachments() -> std::expected<bool, RenderGraphError> {
-    for (i32 i = 0; i < _orderedPasses.size(); i++) {
-        auto &pass = _orderedPasses[i];
+    // looked up by pass index as a pass can access disjoint ranges of the same resource more than once
+    i32 passIndex = 0;
+    const auto hasPrevAccess = [&](const i32 resource) {
+        return getPrevAccess(passIndex, resource).passIndex >= 0;
+    };
+    const auto hasNextAccess = [&](const i32 resource) {
+        return getNextAccess(passIndex, resource).passIndex >= 0;
+    };
+
+    const auto loadOp = [&](const RenderPass::Attachment &attachment) {
+        switch (attachment.hint.load) {
+            case AttachmentLoad::LOAD:
+                return LoadOp::LOAD;
+            case AttachmentLoad::CLEAR:
+                return LoadOp::CLEAR;
+            case AttachmentLoad::OVERWRITE:
+                // the render area always spans every attachment, whether each pixel is written is up to the caller
+                return LoadOp::DONT_CARE;
+            default:
+                break;
+        }
+        return hasPrevAccess(attachment.index) ? LoadOp::LOAD : LoadOp::CLEAR;
+    };
+    const auto storeOp = [&](const RenderPass::Attachment &attachment, const ImageInfo &info) {
+        switch (attachment.hint.store) {
+            case AttachmentStore::STORE:
+                return StoreOp::STORE;
+            case AttachmentStore::DISCARD:
+                return StoreOp::DONT_CARE;
+            default:
+                break;
+        }
+        if (hasNextAccess(attachment.index))
+            return StoreOp::STORE;
+        // external images are read outside the graph, transient ones are never read again
+        return info.external || info.swapchainImage ? StoreOp::STORE : StoreOp::DONT_CARE;
+    };
+
+    for (; passIndex < _orderedPasses.size(); passIndex++) {
+        auto &pass = _orderedPasses[passIndex];
 
         pass._renderingColourAttachments.clear();
 
@@ -2052,16 +3565,13 @@ auto canta::RenderGraph::buildRenderAttachments() -> std::expected<bool, RenderG
             const auto resource = _resources[attachment.index];
             if (!std::holds_alternative<ImageInfo>(resource.info))
                 return std::unexpected(RenderGraphError::INVALID_RESOURCE);
-            const auto image = std::get<ImageInfo>(resource.info).image;
-
-            const auto prevAccess = getPrevAccess(i, attachment.index);
-            const auto nextAccess = getNextAccess(i, attachment.index);
+            const auto &info = std::get<ImageInfo>(resource.info);
 
             canta::Attachment renderingAttachment = {};
-            renderingAttachment.image = image;
+            renderingAttachment.image = info.image;
             renderingAttachment.imageLayout = attachment.layout;
-            renderingAttachment.loadOp = prevAccess.passIndex > -1 ? LoadOp::LOAD : LoadOp::CLEAR;
-            renderingAttachment.storeOp = nextAccess.passIndex > -1 ? StoreOp::STORE : StoreOp::NONE;
+            renderingAttachment.loadOp = loadOp(attachment);
+            renderingAttachment.storeOp = storeOp(attachment, info);
             renderingAttachment.clearColour = attachment.clearColor;
 
             pass._renderingColourAttachments.push_back(renderingAttachment);
@@ -2071,16 +3581,13 @@ auto canta::RenderGraph::buildRenderAttachments() -> std::expected<bool, RenderG
             const auto resource = _resources[pass._depthAttachment.index];
             if (!std::holds_alternative<ImageInfo>(resource.info))
                 return std::unexpected(RenderGraphError::INVALID_RESOURCE);
-            const auto image = std::get<ImageInfo>(resource.info).image;
-
-            const auto prevAccess = getPrevAccess(i, pass._depthAttachment.index);
-            const auto nextAccess = getNextAccess(i, pass._depthAttachment.index);
+            const auto &info = std::get<ImageInfo>(resource.info);
 
             canta::Attachment renderingAttachment = {};
-            renderingAttachment.image = image;
+            renderingAttachment.image = info.image;
             renderingAttachment.imageLayout = pass._depthAttachment.layout;
-            renderingAttachment.loadOp = prevAccess.passIndex > -1 ? LoadOp::LOAD : LoadOp::CLEAR;
-            renderingAttachment.storeOp = nextAccess.passIndex > -1 ? StoreOp::STORE : StoreOp::NONE;
+            renderingAttachment.loadOp = loadOp(pass._depthAttachment);
+            renderingAttachment.storeOp = storeOp(pass._depthAttachment, info);
             renderingAttachment.clearColour = pass._depthAttachment.clearColor;
 
             pass._renderingDepthAttachment = renderingAttachment;
@@ -2090,6 +3597,31 @@ auto canta::RenderGraph::buildRenderAttachments() -> std::expected<bool, RenderG
     return true;
 }
 
+auto canta::RenderGraph::resolvePushConstants() -> std::expected<bool, RenderGraphError> {
+    // resolved once per compile so running a pass doesnt copy handles or push data
+    for (auto &pass : _orderedPasses) {
+        for (const auto &deferredConstant : pass._deferredPushConstants) {
+            const auto index = deferredConstant.type == 0 ? std::get<BufferIndex>(deferredConstant.value).index : std::get<ImageIndex>(deferredConstant.value).index;
+            if (index < 0 || index >= _resources.size())
+                return std::unexpected(RenderGraphError::INVALID_RESOURCE);
+            const auto &info = _resources[index].info;
+
+            if (deferredConstant.type == 0) {
+                if (!std::holds_alternative<BufferInfo>(info) || !std::get<BufferInfo>(info).buffer)
+                    return std::unexpected(RenderGraphError::INVALID_RESOURCE);
+                const auto address = std::get<BufferInfo>(info).buffer->address();
+                std::memcpy(pass._pushData.data.data() + deferredConstant.offset, &address, sizeof(address));
+            } else {
+                if (!std::holds_alternative<ImageInfo>(info) || !std::get<ImageInfo>(info).image)
+                    return std::unexpected(RenderGraphError::INVALID_RESOURCE);
+                const auto id = std::get<ImageInfo>(info).image->defaultView().index();
+                std::memcpy(pass._pushData.data.data() + deferredConstant.offset, &id, sizeof(id));
+            }
+        }
+    }
+    return true;
+}
+
 auto canta::RenderGraph::validateGraphResource(BufferIndex index) const -> std::expected<bool, RenderGraphError> {
     if (index.graphIndex != _graphIndex || index.id < 0 || index.index < 0)
         return std::unexpected(RenderGraphError::INVALID_RESOURCE);
@@ -2115,6 +3647,9 @@ auto canta::RenderGraph::stats() const -> Stats {
     const auto graphicsCommandsCount = poolGroup[0].bufferCount();
     const auto computeCommandsCount = poolGroup[1].bufferCount();
     const auto transferCommandsCount = poolGroup[2].bufferCount();
+    const u32 recordingCommandsCount = std::accumulate(_recordingPools[_device->flyingIndex()].begin(), _recordingPools[_device->flyingIndex()].end(), 0, [](const u32 &lhs, const CommandPool &rhs) {
+        return lhs + rhs.bufferCount();
+    });
 
     const u32 bufferCount = std::accumulate(_resources.begin(), _resources.end(), 0, [](const u32 &lhs, const Resource &rhs) {
         if (std::holds_alternative<BufferInfo>(rhs.info))
@@ -2128,11 +3663,30 @@ auto canta::RenderGraph::stats() const -> Stats {
         return lhs + 0;
     });
 
+    const u32 barrierCount = std::accumulate(_orderedPasses.begin(), _orderedPasses.end(), 0, [](const u32 &lhs, const RenderPass &rhs) {
+        return lhs + static_cast<u32>(rhs._barriers.size());
+    });
+
+    const u32 splitBarrierCount = std::accumulate(_eventBarriers.begin(), _eventBarriers.end(), 0, [](const u32 &lhs, const EventBarrier &rhs) {
+        return lhs + static_cast<u32>(rhs.barriers.size());
+    });
+
     return {
         .passes = static_cast<u32>(_orderedPasses.size()),
-        .commandBuffers = graphicsCommandsCount + computeCommandsCount + transferCommandsCount,
+        .commandBuffers = graphicsCommandsCount + computeCommandsCount + transferCommandsCount + recordingCommandsCount,
         .resources = static_cast<u32>(_resources.size()),
         .images = imageCount,
         .buffers = bufferCount,
+        .transientMemory = _transientMemory,
+        .naiveTransientMemory = _naiveTransientMemory,
+        .barriers = barrierCount,
+        .elidedBarriers = _elidedBarriers,
+        .splitBarriers = splitBarrierCount,
+        .barriersBeforeReorder = _barriersBeforeReorder,
+        .barriersAfterReorder = _barriersAfterReorder,
+        .queueSubmits = _submitCount,
+        .recordedBatches = _recordedBatches,
+        .pooledResources = static_cast<u32>(_bufferPool.size() + _imagePool.size()),
+        .passAllocations = *_passAllocations,
     };
 }
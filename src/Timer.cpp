@@ -12,6 +12,7 @@ canta::Timer::Timer(canta::Timer &&rhs) noexcept {
     std::swap(_queryPoolIndex, rhs._queryPoolIndex);
     std::swap(_index, rhs._index);
     std::swap(_value, rhs._value);
+    std::swap(_start, rhs._start);
 }
 
 auto canta::Timer::operator=(canta::Timer &&rhs) noexcept -> Timer & {
@@ -19,6 +20,7 @@ auto canta::Timer::operator=(canta::Timer &&rhs) noexcept -> Timer & {
     std::swap(_queryPoolIndex, rhs._queryPoolIndex);
     std::swap(_index, rhs._index);
     std::swap(_value, rhs._value);
+    std::swap(_start, rhs._start);
     return *this;
 }
 
@@ -27,6 +29,7 @@ void canta::Timer::begin(canta::CommandBuffer &commandBuffer, canta::PipelineSta
     vkCmdResetQueryPool(commandBuffer.buffer(), pool, _index * 2, 2);
     vkCmdWriteTimestamp2(commandBuffer.buffer(), static_cast<VkPipelineStageFlagBits>(stage), pool, _index * 2);
     _value = 0;
+    _start = 0;
 }
 
 void canta::Timer::end(canta::CommandBuffer &commandBuffer, canta::PipelineStage stage) {
@@ -45,6 +48,9 @@ auto canta::Timer::result() -> std::expected<u64, VulkanError> {
         return 0;
     if (res != VK_SUCCESS)
         return std::unexpected(static_cast<VulkanError>(res));
-    _value = (buffer[1] - buffer[0]) * static_cast<u64>(_device->limits().timestampPeriod);
+    // period can be below 1 so scale before truncating
+    const auto period = static_cast<f64>(_device->limits().timestampPeriod);
+    _value = static_cast<u64>(static_cast<f64>(buffer[1] - buffer[0]) * period);
+    _start = static_cast<u64>(static_cast<f64>(buffer[0]) * period);
     return _value;
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <Canta/debug/TraceExporter.h>
+#include <format>
+#include <fstream>
+
+constexpr u32 CPU_PROCESS = 1;
+constexpr u32 GPU_PROCESS = 2;
+
+inline auto escapeJson(const std::string_view str) -> std::string {
+    std::string escaped = {};
+    escaped.reserve(str.size());
+    for (const auto c : str) {
+        switch (c) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            if (static_cast<u8>(c) < 0x20)
+                escaped += std::format("\\u{:04x}", static_cast<u32>(c));
+            else
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+auto canta::TraceExporter::create(const CreateInfo &info) -> TraceExporter {
+    TraceExporter exporter = {};
+    exporter._renderGraph = info.renderGraph;
+    exporter._maxFrames = info.maxFrames;
+    return exporter;
+}
+
+void canta::TraceExporter::capture() {
+    if (!_renderGraph)
+        return;
+
+    std::vector<Event> events = {};
+
+    // every frame completed since the last capture that is still held by the graph
+    const auto cpuFrame = _renderGraph->cpuFrameCount();
+    const auto newFrames = std::min(cpuFrame - std::min(_cpuFrame, cpuFrame), RenderGraph::CPU_TIMING_FRAMES);
+    for (u32 framesAgo = newFrames; framesAgo-- > 0;) {
+        for (const auto &timing : _renderGraph->cpuTimings(framesAgo)) {
+            events.push_back({
+                .name = timing.name,
+                .category = timing.category,
+                .start = timing.start,
+                .duration = timing.duration,
+                .process = CPU_PROCESS,
+                .thread = timing.thread,
+            });
+        }
+    }
+    _cpuFrame = cpuFrame;
+
+    // without calibration gpu events stay on the device clock, still usable for queue overlap but not against the cpu
+    i64 offset = 0;
+    if (const auto calibration = _renderGraph->device()->calibrateTimestamps(); calibration)
+        offset = static_cast<i64>(calibration->host) - static_cast<i64>(calibration->device);
+
+    for (auto &info : _renderGraph->timers()) {
+        const auto duration = info.timer.result();
+        if (!duration || *duration == 0)
+            continue;
+        events.push_back({
+            .name = info.name,
+            .category = "gpu",
+            .start = static_cast<u64>(static_cast<i64>(info.timer.start()) + offset),
+            .duration = *duration,
+            .process = GPU_PROCESS,
+            .thread = static_cast<u32>(info.queue),
+        });
+    }
+
+    _frames.push_back(std::move(events));
+    while (_maxFrames > 0 && _frames.size() > _maxFrames)
+        _frames.pop_front();
+}
+
+auto canta::TraceExporter::json() const -> std::string {
+    u64 base = std::numeric_limits<u64>::max();
+    for (const auto &frame : _frames) {
+        for (const auto &event : frame)
+            base = std::min(base, event.start);
+    }
+
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    json += std::format(R"({{"name":"process_name","ph":"M","pid":{},"tid":0,"args":{{"name":"cpu"}}}})", CPU_PROCESS);
+    json += std::format(R"(,{{"name":"process_name","ph":"M","pid":{},"tid":0,"args":{{"name":"gpu"}}}})", GPU_PROCESS);
+    for (const auto queue : {QueueType::GRAPHICS, QueueType::COMPUTE, QueueType::TRANSFER}) {
+        json += std::format(R"(,{{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{"name":"{}"}}}})", GPU_PROCESS, static_cast<u32>(queue), queueTypeString(queue));
+    }
+
+    for (const auto &frame : _frames) {
+        for (const auto &event : frame) {
+            // timestamps are in microseconds
+            json += std::format(R"(,{{"name":"{}","cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":{},"tid":{}}})",
+                                escapeJson(event.name), event.category, static_cast<f64>(event.start - base) / 1000.0,
+                                static_cast<f64>(event.duration) / 1000.0, event.process, event.thread);
+        }
+    }
+    json += "]}";
+    return json;
+}
+
+auto canta::TraceExporter::write(const std::filesystem::path &path) const -> bool {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+    file << json();
+    return static_cast<bool>(file);
+}
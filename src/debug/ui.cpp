@@ -37,6 +37,8 @@ auto canta::drawResourceStats(const Device::ResourceStats &stats, std::string_vi
         ImGui::Text("Sampler Allocated: %d", stats.shaderAllocated);
         ImGui::Text("Timestamp Query Pools: %d", stats.timestampQueryPools);
         ImGui::Text("PipelineStats Pools: %d", stats.pipelineStatsPools);
+        ImGui::Text("Queued For Destruction: %d", stats.queuedForDestruction);
+        ImGui::Text("Destroyed: %d", stats.destroyed);
     }
     if (!name.empty())
         ImGui::End();
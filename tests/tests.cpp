@@ -1,9 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <thread>
 
 #include <Canta/ResourceList.h>
 #include <Canta/Buffer.h>
 #include <Canta/RenderGraph.h>
 #include <Canta/PipelineManager.h>
+#include <Canta/debug/TraceExporter.h>
 
 
 TEST_CASE("Resource reference counting", "[refcount]") {
@@ -40,6 +43,169 @@ TEST_CASE("Resource reference counting", "[refcount]") {
         REQUIRE(handle1.index() == oldIndex);
     }
 
+    SECTION("reallocate") {
+        auto oldIndex = handle.index();
+        auto copy = handle;
+        auto newHandle = list.reallocate(handle);
+
+        REQUIRE(newHandle == handle);
+        REQUIRE(copy.index() == newHandle.index());
+        REQUIRE(newHandle.index() != oldIndex);
+        REQUIRE(list.toDestroy() == 1);
+    }
+
+    SECTION("ref") {
+        auto ref = handle.ref();
+
+        REQUIRE(ref);
+        REQUIRE(ref.index() == handle.index());
+        REQUIRE(handle.count() == 1);
+        REQUIRE(&*ref == &*handle);
+
+        list.clearAll();
+        REQUIRE(!ref);
+    }
+
+}
+
+TEST_CASE("Resource destruction queue", "[refcount]") {
+    u64 timeline = 0;
+    auto list = canta::ResourceList<canta::Buffer>::create(1, {}, [&] { return timeline; });
+    std::vector<canta::BufferHandle> handles = {};
+    for (u32 i = 0; i < 8; i++)
+        handles.push_back(list.allocate());
+
+    handles.resize(4);
+    timeline++;
+    handles.resize(2);
+    list.clearQueue();
+
+    REQUIRE(list.queued() == 6);
+    REQUIRE(list.destroyed() == 0);
+    REQUIRE(list.toDestroy() == 6);
+
+    timeline = 2;
+    list.clearQueue();
+
+    REQUIRE(list.queued() == 0);
+    REQUIRE(list.destroyed() == 4);
+    REQUIRE(list.toDestroy() == 2);
+
+    timeline = 3;
+    list.clearQueue();
+
+    REQUIRE(list.destroyed() == 2);
+    REQUIRE(list.toDestroy() == 0);
+    REQUIRE(list.used() == 2);
+}
+
+TEST_CASE("Resource list concurrent allocation", "[refcount]") {
+    std::atomic<u64> timeline = 0;
+    auto list = canta::ResourceList<canta::Buffer>::create(1, {}, [&] { return timeline.load(); });
+
+    // set while a handle to the index is alive, a slot handed out twice finds it already set
+    std::vector<std::atomic<bool>> live(1 << 16);
+    std::atomic<bool> duplicate = false;
+    std::atomic<bool> done = false;
+
+    std::thread collector([&] {
+        while (!done) {
+            timeline++;
+            list.clearQueue();
+        }
+    });
+    std::vector<std::thread> threads = {};
+    for (u32 thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&] {
+            std::vector<canta::BufferHandle> handles = {};
+            for (u32 i = 0; i < 10000; i++) {
+                auto handle = list.allocate();
+                if (live[handle.index()].exchange(true))
+                    duplicate = true;
+                handles.push_back(std::move(handle));
+                if (handles.size() > 8) {
+                    live[handles.front().index()] = false;
+                    handles.erase(handles.begin());
+                }
+            }
+            for (auto& handle : handles)
+                live[handle.index()] = false;
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    done = true;
+    collector.join();
+
+    REQUIRE(!duplicate);
+    timeline += 2;
+    list.clearQueue();
+    list.clearQueue();
+    REQUIRE(list.toDestroy() == 0);
+    REQUIRE(list.used() == 0);
+    REQUIRE(list.free() == list.allocated());
+}
+
+TEST_CASE("Handle dereference benchmark", "[!benchmark][refcount]") {
+    canta::ResourceList<canta::Buffer> list;
+    std::vector<canta::BufferHandle> handles = {};
+    std::vector<canta::BufferRef> refs = {};
+    for (u32 i = 0; i < 1024; i++) {
+        handles.push_back(list.allocate());
+        refs.push_back(handles.back().ref());
+    }
+
+    BENCHMARK("handle dereference") {
+        u64 sum = 0;
+        for (const auto& handle : handles)
+            sum += handle->size();
+        return sum;
+    };
+
+    BENCHMARK("ref dereference") {
+        u64 sum = 0;
+        for (const auto& ref : refs)
+            sum += ref->size();
+        return sum;
+    };
+
+    BENCHMARK("handle copy") {
+        auto copies = handles;
+        return copies.size();
+    };
+
+    BENCHMARK("ref copy") {
+        auto copies = refs;
+        return copies.size();
+    };
+}
+
+TEST_CASE("Bindless descriptor updates", "[device]") {
+    auto device = canta::Device::create({
+        .applicationName = "tests",
+        .headless = true,
+        .logLevel = spdlog::level::err
+    }).value();
+
+    std::vector<canta::ImageHandle> images = {};
+    std::vector<canta::BufferHandle> buffers = {};
+    for (u32 i = 0; i < 3; i++) {
+        images.push_back(device->createImage({ .width = 16, .height = 16, .usage = canta::ImageUsage::SAMPLED | canta::ImageUsage::STORAGE, .name = "image" }));
+        buffers.push_back(device->createBuffer({ .size = 64, .usage = canta::BufferUsage::STORAGE, .name = "buffer" }));
+    }
+    REQUIRE(device->pendingDescriptorUpdates() >= images.size() + buffers.size());
+
+    // each frame in flight has its own set so updates stay queued until every set has been written
+    for (u32 frame = 0; frame < canta::FRAMES_IN_FLIGHT; frame++) {
+        REQUIRE(device->pendingDescriptorUpdates() > 0);
+        REQUIRE(device->beginFrame());
+        REQUIRE(device->frameSemaphore()->signal(device->frameValue()));
+    }
+    REQUIRE(device->pendingDescriptorUpdates() == 0);
+
+    // flushing again with nothing queued writes nothing
+    device->updateBindlessDescriptors();
+    REQUIRE(device->pendingDescriptorUpdates() == 0);
 }
 
 TEST_CASE("PipelineManager", "[pipelinemanager]") {
@@ -149,4 +315,609 @@ TEST_CASE("RenderGraph", "[rendergraph]") {
         REQUIRE(!renderGraph.compile().has_value());
     }
 
-}
\ No newline at end of file
+    SECTION("subresource barriers") {
+        auto mips = renderGraph.addImage({ .width = 64, .height = 64, .mips = 2, .name = "mips" });
+
+        auto pass1 = renderGraph.compute("mip0")
+                .addStorageImageWrite(mips, { .mip = 0, .mipCount = 1 });
+
+        auto pass2 = renderGraph.compute("mip1")
+                .addStorageImageWrite(mips, { .mip = 1, .mipCount = 1 });
+
+        auto pass3 = renderGraph.compute("resolve")
+                .addStorageImageRead(*pass1.output<canta::ImageIndex>())
+                .addStorageImageRead(*pass2.output<canta::ImageIndex>())
+                .addStorageImageWrite(backbuffer);
+
+        renderGraph.setRoot(*pass3.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        // disjoint mip writes only transition their own mip, the full read then needs one barrier per existing mip
+        REQUIRE(renderGraph.stats().barriers == 5);
+
+        const auto mipRanges = [&](const canta::RenderPass& pass) {
+            std::vector<std::pair<u32, u32>> ranges = {};
+            for (const auto& barrier : pass.barriers()) {
+                if (barrier.index == mips.index)
+                    ranges.emplace_back(barrier.subresource.mip, barrier.subresource.mipCount);
+            }
+            std::ranges::sort(ranges);
+            return ranges;
+        };
+        using Ranges = std::vector<std::pair<u32, u32>>;
+        const auto passes = renderGraph.passes();
+        REQUIRE(passes.size() == 3);
+        REQUIRE(mipRanges(passes[0]) == Ranges{{0, 1}});
+        REQUIRE(mipRanges(passes[1]) == Ranges{{1, 1}});
+        REQUIRE(mipRanges(passes[2]) == Ranges{{0, 1}, {1, 1}});
+    }
+
+    SECTION("buffer range barriers") {
+        auto buffer = renderGraph.addBuffer({ .size = 256, .name = "packed" });
+
+        auto pass1 = renderGraph.compute("first")
+                .addStorageBufferWrite(buffer, { .offset = 0, .size = 128 });
+
+        auto pass2 = renderGraph.compute("second")
+                .addStorageBufferWrite(buffer, { .offset = 128, .size = 128 });
+
+        auto pass3 = renderGraph.compute("consume")
+                .addStorageBufferRead(*pass1.output<canta::BufferIndex>())
+                .addStorageBufferRead(*pass2.output<canta::BufferIndex>())
+                .addStorageImageWrite(backbuffer);
+
+        renderGraph.setRoot(*pass3.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        // disjoint writes dont wait on each other and the full read only covers the bytes the buffer has
+        REQUIRE(renderGraph.stats().barriers == 5);
+
+        const auto byteRanges = [&](const canta::RenderPass& pass) {
+            std::vector<std::pair<u32, u32>> ranges = {};
+            for (const auto& barrier : pass.barriers()) {
+                if (barrier.index == buffer.index)
+                    ranges.emplace_back(barrier.range.offset, barrier.range.size);
+            }
+            std::ranges::sort(ranges);
+            return ranges;
+        };
+        using Ranges = std::vector<std::pair<u32, u32>>;
+        const auto passes = renderGraph.passes();
+        REQUIRE(passes.size() == 3);
+        REQUIRE(byteRanges(passes[0]) == Ranges{{0, 128}});
+        REQUIRE(byteRanges(passes[1]) == Ranges{{128, 128}});
+        REQUIRE(byteRanges(passes[2]) == Ranges{{0, 128}, {128, 128}});
+    }
+
+    SECTION("read barrier elision") {
+        auto image = renderGraph.addImage({ .width = 64, .height = 64, .name = "shared image" });
+        auto buffer = renderGraph.addBuffer({ .size = 64, .name = "shared buffer" });
+
+        auto writer = renderGraph.compute("writer")
+                .addStorageImageWrite(image)
+                .addStorageBufferWrite(buffer);
+        image = *writer.output<canta::ImageIndex>();
+        buffer = *writer.output<canta::BufferIndex>(1);
+
+        auto resolve = renderGraph.compute("resolve")
+                .addStorageImageWrite(backbuffer);
+        for (u32 i = 0; i < 2; i++) {
+            auto result = renderGraph.addBuffer({ .size = 64, .name = "result" });
+            auto reader = renderGraph.compute("compute reader")
+                    .addSampledRead(image)
+                    .addStorageBufferRead(buffer)
+                    .addStorageBufferWrite(result);
+            resolve.addStorageBufferRead(*reader.output<canta::BufferIndex>());
+        }
+        auto colour = renderGraph.addImage({ .width = 64, .height = 64, .name = "colour" });
+        auto draw = renderGraph.graphics("graphics reader")
+                .addSampledRead(image, canta::PipelineStage::FRAGMENT_SHADER)
+                .addColourWrite(colour);
+        resolve.addSampledRead(*draw.output<canta::ImageIndex>());
+
+        renderGraph.setRoot(*resolve.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        // only the first of the three image reads and two buffer reads keeps its barrier
+        REQUIRE(renderGraph.stats().elidedBarriers == 3);
+
+        const auto readBarriers = [&](const i32 index) {
+            std::vector<canta::RenderPass::Barrier> barriers = {};
+            for (const auto& pass : renderGraph.passes()) {
+                for (const auto& barrier : pass.barriers()) {
+                    if (barrier.index == index && barrier.prevPassIndex > -1)
+                        barriers.push_back(barrier);
+                }
+            }
+            return barriers;
+        };
+        // the surviving barrier waits for the write on behalf of every reader
+        const auto imageBarriers = readBarriers(image.index);
+        REQUIRE(imageBarriers.size() == 1);
+        const auto readStages = canta::PipelineStage::COMPUTE_SHADER | canta::PipelineStage::FRAGMENT_SHADER;
+        REQUIRE((imageBarriers[0].dstStage & readStages) == readStages);
+        REQUIRE((imageBarriers[0].dstAccess & canta::Access::SHADER_READ) == canta::Access::SHADER_READ);
+        REQUIRE(imageBarriers[0].dstLayout == canta::ImageLayout::SHADER_READ_ONLY);
+
+        const auto bufferBarriers = readBarriers(buffer.index);
+        REQUIRE(bufferBarriers.size() == 1);
+        REQUIRE((bufferBarriers[0].dstStage & canta::PipelineStage::COMPUTE_SHADER) == canta::PipelineStage::COMPUTE_SHADER);
+        REQUIRE((bufferBarriers[0].dstAccess & canta::Access::SHADER_READ) == canta::Access::SHADER_READ);
+    }
+
+    SECTION("pass reordering") {
+        renderGraph.setMultiQueue(true);
+        renderGraph.setReorderPasses(true);
+        std::array<canta::ImageIndex, 2> images = {};
+        for (auto& image : images) {
+            auto writer = renderGraph.compute("writer")
+                    .addStorageImageWrite(renderGraph.addImage({ .width = 64, .height = 64, .name = "image" }));
+            image = *writer.output<canta::ImageIndex>();
+        }
+        // independent readers alternating between the two images, multi queue moves one of them to async compute
+        auto resolve = renderGraph.compute("resolve")
+                .addStorageImageWrite(backbuffer);
+        for (u32 i = 0; i < 6; i++) {
+            auto result = renderGraph.addBuffer({ .size = 64, .name = "result" });
+            auto reader = renderGraph.compute("reader")
+                    .addSampledRead(images[i % 2])
+                    .addStorageBufferWrite(result);
+            resolve.addStorageBufferRead(*reader.output<canta::BufferIndex>());
+        }
+        renderGraph.setRoot(*resolve.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.stats().barriersBeforeReorder > 0);
+        REQUIRE(renderGraph.stats().barriersAfterReorder <= renderGraph.stats().barriersBeforeReorder);
+        REQUIRE(renderGraph.run({}, {}, false));
+    }
+
+    SECTION("pass reordering write after read") {
+        auto shared = renderGraph.addImage({ .width = 64, .height = 64, .name = "shared" });
+        auto target = renderGraph.addImage({ .width = 64, .height = 64, .name = "target" });
+        auto writer = renderGraph.compute("writer")
+                .addSampledRead(shared)
+                .addStorageImageWrite(target);
+        target = *writer.output<canta::ImageIndex>();
+
+        // overwrite shares a read with writer so would be picked first if nothing kept it after reader
+        auto result = renderGraph.addBuffer({ .size = 64, .name = "result" });
+        auto reader = renderGraph.compute("reader")
+                .addSampledRead(target)
+                .addStorageBufferWrite(result);
+        auto overwrite = renderGraph.compute("overwrite")
+                .addSampledRead(shared)
+                .addStorageImageWrite(target);
+        auto resolve = renderGraph.compute("resolve")
+                .addStorageBufferRead(*reader.output<canta::BufferIndex>())
+                .addStorageImageRead(*overwrite.output<canta::ImageIndex>())
+                .addStorageImageWrite(backbuffer);
+        renderGraph.setRoot(*resolve.output<canta::ImageIndex>());
+
+        const auto position = [&](const std::string_view name) {
+            const auto passes = renderGraph.passes();
+            return std::ranges::find_if(passes, [&](const auto& pass) { return pass.name() == name; }) - passes.begin();
+        };
+        REQUIRE(renderGraph.compile());
+        const bool readerFirst = position("reader") < position("overwrite");
+
+        renderGraph.setReorderPasses(true);
+        REQUIRE(renderGraph.compile());
+        REQUIRE((position("reader") < position("overwrite")) == readerFirst);
+        REQUIRE(renderGraph.stats().barriersAfterReorder <= renderGraph.stats().barriersBeforeReorder);
+    }
+
+    SECTION("split barriers") {
+        renderGraph.setSplitBarriers(true);
+        auto produced = renderGraph.addBuffer({ .size = 64, .name = "produced" });
+        auto link = renderGraph.addBuffer({ .size = 64, .name = "link" });
+        auto unrelated = renderGraph.addBuffer({ .size = 64, .name = "unrelated" });
+
+        // link keeps the unrelated pass between producer and consumer without touching produced
+        auto producer = renderGraph.compute("producer")
+                .addStorageBufferWrite(produced)
+                .addStorageBufferWrite(link);
+        auto middle = renderGraph.compute("middle")
+                .addStorageBufferRead(*producer.output<canta::BufferIndex>(1))
+                .addStorageBufferWrite(unrelated);
+        auto consumer = renderGraph.compute("consumer")
+                .addStorageBufferRead(*producer.output<canta::BufferIndex>())
+                .addStorageBufferRead(*middle.output<canta::BufferIndex>())
+                .addStorageImageWrite(backbuffer);
+        renderGraph.setRoot(*consumer.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+
+        const auto passes = renderGraph.passes();
+        REQUIRE(passes.size() == 3);
+        REQUIRE(passes[2].name() == "consumer");
+        const auto hasBarrier = [](const canta::RenderPass& pass, const i32 index) {
+            return std::ranges::any_of(pass.barriers(), [&](const auto& barrier) { return barrier.index == index; });
+        };
+        // the producer to consumer barrier skips a pass so becomes an event, adjacent pairs stay plain barriers
+        REQUIRE(renderGraph.stats().splitBarriers > 0);
+        REQUIRE(!hasBarrier(passes[2], produced.index));
+        REQUIRE(hasBarrier(passes[2], unrelated.index));
+        REQUIRE(hasBarrier(passes[1], link.index));
+        // records the event set, wait and reset
+        REQUIRE(renderGraph.run({}, {}, false));
+    }
+
+    SECTION("split barriers across queues") {
+        if (!device->queueEnabled(canta::QueueType::TRANSFER))
+            SKIP("no transfer queue");
+        renderGraph.setMultiQueue(true);
+        renderGraph.setSplitBarriers(true);
+        auto produced = renderGraph.addBuffer({ .size = 64, .name = "produced" });
+        auto link = renderGraph.addBuffer({ .size = 64, .name = "link" });
+        auto copied = renderGraph.addBuffer({ .size = 64, .name = "copied" });
+
+        auto producer = renderGraph.compute("producer")
+                .addStorageBufferWrite(produced)
+                .addStorageBufferWrite(link);
+        auto copy = renderGraph.transfer("copy")
+                .addTransferRead(*producer.output<canta::BufferIndex>(1))
+                .addTransferWrite(copied);
+        auto consumer = renderGraph.compute("consumer")
+                .addStorageBufferRead(*producer.output<canta::BufferIndex>())
+                .addStorageBufferRead(*copy.output<canta::BufferIndex>())
+                .addStorageImageWrite(backbuffer);
+        renderGraph.setRoot(*consumer.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+
+        // events cant be waited on from another queue so every barrier stays plain
+        const auto passes = renderGraph.passes();
+        REQUIRE(passes.size() == 3);
+        REQUIRE(passes[1].queue() == canta::QueueType::TRANSFER);
+        REQUIRE(renderGraph.stats().splitBarriers == 0);
+        REQUIRE(std::ranges::any_of(passes[2].barriers(), [&](const auto& barrier) { return barrier.index == produced.index; }));
+        REQUIRE(renderGraph.run({}, {}, false));
+    }
+
+    SECTION("queue submits") {
+        renderGraph.setMultiQueue(true);
+        auto first = renderGraph.compute("first")
+                .addStorageBufferWrite(renderGraph.addBuffer({ .size = 64, .name = "first" }));
+        auto copy = renderGraph.transfer("copy")
+                .addTransferRead(*first.output<canta::BufferIndex>())
+                .addTransferWrite(renderGraph.addBuffer({ .size = 64, .name = "copied" }));
+        auto host = renderGraph.host("host")
+                .read(*copy.output<canta::BufferIndex>())
+                .write(renderGraph.addBuffer({ .size = 64, .name = "host" }))
+                .setCallback([](canta::RenderGraph&) {});
+        auto second = renderGraph.compute("second")
+                .addStorageBufferRead(*host.output<canta::BufferIndex>())
+                .addStorageImageWrite(backbuffer);
+        renderGraph.setRoot(*second.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+
+        // the host pass splits the graphics work in two but each queue still gets a single submit
+        std::vector<canta::QueueType> queues = {};
+        for (const auto& pass : renderGraph.passes()) {
+            if (pass.queue() != canta::QueueType::NONE && std::ranges::find(queues, pass.queue()) == queues.end())
+                queues.push_back(pass.queue());
+        }
+        REQUIRE(renderGraph.stats().queueSubmits == queues.size());
+    }
+
+    SECTION("attachment ops") {
+        auto loaded = renderGraph.addImage({ .width = 64, .height = 64, .name = "loaded" });
+        auto cleared = renderGraph.addImage({ .width = 64, .height = 64, .name = "cleared" });
+        auto overwritten = renderGraph.addImage({ .width = 64, .height = 64, .name = "overwritten" });
+        const auto clear = std::to_array({0.f, 0.f, 0.f, 1.f});
+
+        auto pass1 = renderGraph.graphics("draw")
+                .addColourWrite(loaded, clear, { .load = canta::AttachmentLoad::LOAD, .store = canta::AttachmentStore::STORE })
+                .addColourWrite(cleared, clear, { .load = canta::AttachmentLoad::CLEAR, .store = canta::AttachmentStore::DISCARD })
+                .addColourWrite(overwritten, clear, { .load = canta::AttachmentLoad::OVERWRITE });
+
+        auto pass2 = renderGraph.compute("consume")
+                .addStorageImageRead(*pass1.output<canta::ImageIndex>(2))
+                .addStorageImageWrite(backbuffer);
+
+        renderGraph.setRoot(*pass2.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+
+        const auto passes = renderGraph.passes();
+        REQUIRE(passes.size() == 2);
+        const auto attachments = passes[0].renderingColourAttachments();
+        REQUIRE(attachments.size() == 3);
+        REQUIRE(attachments[0].loadOp == canta::LoadOp::LOAD);
+        REQUIRE(attachments[0].storeOp == canta::StoreOp::STORE);
+        REQUIRE(attachments[1].loadOp == canta::LoadOp::CLEAR);
+        REQUIRE(attachments[1].storeOp == canta::StoreOp::DONT_CARE);
+        // read afterwards so stored without a hint
+        REQUIRE(attachments[2].loadOp == canta::LoadOp::DONT_CARE);
+        REQUIRE(attachments[2].storeOp == canta::StoreOp::STORE);
+    }
+
+    SECTION("transient aliasing reuse") {
+        renderGraph.setTransientAliasing(true);
+        auto intermediate = renderGraph.addImage({ .width = 64, .height = 64, .name = "intermediate" });
+
+        auto pass1 = renderGraph.compute("produce")
+                .addStorageImageWrite(intermediate);
+
+        auto pass2 = renderGraph.compute("consume")
+                .addStorageImageRead(*pass1.output<canta::ImageIndex>())
+                .addStorageImageWrite(backbuffer);
+
+        renderGraph.setRoot(*pass2.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        const auto image = *renderGraph.getImage(intermediate);
+        REQUIRE(image->aliased());
+
+        // an unchanged placement keeps its image whether the graph is patched or rebuilt
+        REQUIRE(renderGraph.compile());
+        REQUIRE(*renderGraph.getImage(intermediate) == image);
+        renderGraph.invalidate();
+        REQUIRE(renderGraph.compile());
+        REQUIRE(*renderGraph.getImage(intermediate) == image);
+    }
+
+    SECTION("resource pool") {
+        const auto buildGraph = [&](const u32 size) {
+            auto output = renderGraph.addImage({ .width = size, .height = size, .name = "output" });
+            auto pass = renderGraph.compute("pass")
+                    .addStorageImageWrite(output);
+            renderGraph.setRoot(*pass.output<canta::ImageIndex>());
+            REQUIRE(renderGraph.compile());
+            return *renderGraph.getImage(output);
+        };
+
+        renderGraph.reset();
+        const auto image = buildGraph(64);
+        REQUIRE(renderGraph.stats().pooledResources == 0);
+
+        // images go back to the pool on reset and stay there while their frame could still be in flight
+        renderGraph.reset();
+        REQUIRE(renderGraph.stats().pooledResources == 1);
+        buildGraph(32);
+        REQUIRE(renderGraph.stats().pooledResources == 1);
+
+        // once the frames in flight have passed a matching image is handed back
+        renderGraph.reset();
+        REQUIRE(renderGraph.stats().pooledResources == 2);
+        for (u32 frame = 0; frame < canta::FRAMES_IN_FLIGHT; frame++) {
+            REQUIRE(device->beginFrame());
+            REQUIRE(device->frameSemaphore()->signal(device->frameValue()));
+        }
+        REQUIRE(buildGraph(64) == image);
+        REQUIRE(renderGraph.stats().pooledResources == 1);
+    }
+
+    SECTION("parallel recording") {
+        renderGraph.setParallelRecording(true);
+        auto buffer = renderGraph.addBuffer({ .size = 64, .name = "chain" });
+        for (u32 i = 0; i < 4 * canta::RenderGraph::MIN_BATCH_PASSES; i++) {
+            auto pass = renderGraph.compute("pass")
+                    .addStorageBufferRead(buffer)
+                    .addStorageBufferWrite(buffer);
+            buffer = *pass.output<canta::BufferIndex>();
+        }
+        renderGraph.setRoot(buffer);
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+        // a single queue run is still split across the recording threads
+        REQUIRE(renderGraph.stats().recordedBatches > 1);
+    }
+
+    SECTION("parallel recording external image") {
+        // stands in for a swapchain image, which is only known once the frame runs
+        const auto createTarget = [&] {
+            return device->createImage({ .width = 64, .height = 64, .usage = canta::ImageUsage::STORAGE, .name = "target" });
+        };
+        renderGraph.setParallelRecording(true);
+        renderGraph.reset();
+        auto target = renderGraph.addExternalImage(createTarget());
+        auto buffer = renderGraph.addBuffer({ .size = 64, .name = "chain" });
+        for (u32 i = 0; i < 4 * canta::RenderGraph::MIN_BATCH_PASSES; i++) {
+            auto pass = renderGraph.compute("pass")
+                    .addStorageBufferRead(buffer)
+                    .addStorageBufferWrite(buffer);
+            buffer = *pass.output<canta::BufferIndex>();
+        }
+        auto pass = renderGraph.compute("write target")
+                .addStorageBufferRead(buffer)
+                .addStorageImageWrite(target);
+        renderGraph.setRoot(*pass.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+
+        auto info = *renderGraph.getImageInfo(target);
+        info.image = createTarget();
+        REQUIRE(renderGraph.updateImageInfo(target, info));
+        REQUIRE(renderGraph.run({}, {}, false));
+        REQUIRE(*renderGraph.getImage(target) == info.image);
+        REQUIRE(renderGraph.stats().recordedBatches > 1);
+    }
+
+    SECTION("retained replay") {
+        renderGraph.setRetained(true);
+        renderGraph.reset();
+        auto target = renderGraph.addExternalImage(device->createImage({ .width = 64, .height = 64, .usage = canta::ImageUsage::STORAGE, .name = "target" }));
+        auto pass = renderGraph.compute("write target")
+                .addStorageImageWrite(target);
+        renderGraph.setRoot(*pass.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+        REQUIRE(renderGraph.stats().recordedBatches > 0);
+
+        // unchanged graph replays what it recorded
+        REQUIRE(renderGraph.run({}, {}, false));
+        REQUIRE(renderGraph.stats().recordedBatches == 0);
+
+        // a new image behind the same resource, as after an acquire, is recorded again
+        auto info = *renderGraph.getImageInfo(target);
+        info.image = device->createImage({ .width = 64, .height = 64, .usage = canta::ImageUsage::STORAGE, .name = "target" });
+        REQUIRE(renderGraph.updateImageInfo(target, info));
+        REQUIRE(renderGraph.run({}, {}, false));
+        REQUIRE(renderGraph.stats().recordedBatches > 0);
+        REQUIRE(renderGraph.run({}, {}, false));
+        REQUIRE(renderGraph.stats().recordedBatches == 0);
+
+        renderGraph.invalidate();
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+        REQUIRE(renderGraph.stats().recordedBatches > 0);
+    }
+
+    SECTION("cost scheduling") {
+        if (!device->queueEnabled(canta::QueueType::COMPUTE))
+            SKIP("no async compute queue");
+        renderGraph.setMultiQueue(true);
+        renderGraph.setCostScheduling(true);
+        const auto buildGraph = [&](const u64 heavyCost, const u64 lightCost) {
+            renderGraph.reset();
+            auto consumer = renderGraph.compute("consumer");
+            const std::pair<const char *, u64> producers[] = { { "heavy", heavyCost }, { "heavy", heavyCost }, { "light", lightCost } };
+            for (const auto &[name, cost] : producers) {
+                auto buffer = renderGraph.addBuffer({ .size = 64, .name = "buffer" });
+                auto pass = renderGraph.compute(name)
+                        .addStorageBufferWrite(buffer)
+                        .setCostHint(cost);
+                consumer.addStorageBufferRead(*pass.output<canta::BufferIndex>());
+            }
+            auto output = renderGraph.addBuffer({ .size = 64, .name = "output" });
+            consumer.addStorageBufferWrite(output);
+            renderGraph.setRoot(*consumer.output<canta::BufferIndex>());
+            REQUIRE(renderGraph.compile());
+        };
+        const auto countCompute = [&](const std::string_view name) {
+            return std::ranges::count_if(renderGraph.passes(), [&](const auto &pass) {
+                return pass.name() == name && pass.queue() == canta::QueueType::COMPUTE;
+            });
+        };
+
+        // without costs the last pass of a level moves to async compute
+        buildGraph(0, 0);
+        REQUIRE(countCompute("heavy") + countCompute("light") == 1);
+
+        // hints move the expensive off critical path pass instead, the cheap one isnt worth the queue sync
+        buildGraph(1000000, 100);
+        REQUIRE(countCompute("heavy") == 1);
+        REQUIRE(countCompute("light") == 0);
+        REQUIRE(renderGraph.run({}, {}, false));
+    }
+
+    SECTION("cpu timings") {
+        renderGraph.setCpuProfiling(true);
+        renderGraph.reset();
+        auto output = renderGraph.addImage({ .width = 64, .height = 64, .name = "output" });
+        auto pass = renderGraph.compute("pass")
+                .addStorageImageWrite(output);
+        renderGraph.setRoot(*pass.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+
+        REQUIRE(renderGraph.cpuFrameCount() == 1);
+        const auto timings = renderGraph.cpuTimings(0);
+        const auto contains = [&](const std::string_view category, const std::string_view name) {
+            return std::ranges::any_of(timings, [&](const auto& timing) {
+                return timing.category == category && timing.name == name;
+            });
+        };
+        REQUIRE(contains("build", "build"));
+        REQUIRE(contains("compile", "sort"));
+        REQUIRE(contains("compile", "resources"));
+        REQUIRE(contains("compile", "barriers"));
+        REQUIRE(contains("compile", "compile"));
+        REQUIRE(contains("record", "pass"));
+        REQUIRE(contains("run", "run"));
+        REQUIRE(renderGraph.cpuTimings(1).empty());
+    }
+
+    SECTION("trace export") {
+        renderGraph.setCpuProfiling(true);
+        renderGraph.setTimingMode(canta::RenderGraph::QueryMode::PER_PASS);
+        renderGraph.reset();
+        auto output = renderGraph.addImage({ .width = 64, .height = 64, .name = "output" });
+        auto pass = renderGraph.compute("traced")
+                .addStorageImageWrite(output);
+        renderGraph.setRoot(*pass.output<canta::ImageIndex>());
+        REQUIRE(renderGraph.compile());
+        REQUIRE(renderGraph.run({}, {}, false));
+
+        auto exporter = canta::TraceExporter::create({ .renderGraph = &renderGraph, .maxFrames = 2 });
+        exporter.capture();
+        const auto json = exporter.json();
+        REQUIRE(json.starts_with("{"));
+        REQUIRE(json.ends_with("]}"));
+        REQUIRE(json.contains(R"("name":"compile","cat":"compile","ph":"X")"));
+        REQUIRE(json.contains(R"("name":"traced","cat":"record","ph":"X")"));
+        REQUIRE(json.contains(R"("name":"run","cat":"run","ph":"X")"));
+        REQUIRE(json.contains(R"("name":"traced","cat":"gpu","ph":"X")"));
+
+        // frames already captured arent captured again and old ones are dropped
+        exporter.capture();
+        exporter.capture();
+        REQUIRE(exporter.frameCount() == 2);
+        REQUIRE(!exporter.json().contains(R"("cat":"run")"));
+    }
+
+    SECTION("pass storage reuse") {
+        // measured before compile() as compiling copies the passes
+        const auto buildGraph = [&] {
+            auto output = renderGraph.addImage({ .name = "output" });
+            auto target = renderGraph.addImage({ .name = "target" });
+            auto pass1 = renderGraph.compute("pass1")
+                    .addStorageImageWrite(output);
+            auto pass2 = renderGraph.compute("pass2")
+                    .addStorageImageRead(*pass1.output<canta::ImageIndex>())
+                    .addStorageImageWrite(target);
+            renderGraph.setRoot(*pass2.output<canta::ImageIndex>());
+            const auto allocations = renderGraph.stats().passAllocations;
+            REQUIRE(renderGraph.compile());
+            return allocations;
+        };
+
+        renderGraph.reset();
+        REQUIRE(buildGraph() > 0);
+        // rebuilding the same graph reuses the storage of the last build
+        for (u32 frame = 0; frame < 3; frame++) {
+            renderGraph.reset();
+            REQUIRE(buildGraph() == 0);
+        }
+    }
+
+}
+
+TEST_CASE("RenderGraph compile benchmark", "[!benchmark][rendergraph]") {
+    auto device = canta::Device::create({
+        .applicationName = "tests",
+        .logLevel = spdlog::level::off
+    }).value();
+    auto renderGraph = *canta::RenderGraph::create({
+        .device = device.get(),
+        .name = "benchmark"
+    });
+
+    // chain of passes each reading and writing a ring of buffers
+    const auto buildGraph = [&](const u32 passCount) {
+        renderGraph.reset();
+        std::array<canta::BufferIndex, 16> buffers = {};
+        for (auto& buffer : buffers)
+            buffer = renderGraph.addBuffer({ .size = 64, .name = "buffer" });
+
+        for (u32 i = 0; i < passCount; i++) {
+            auto pass = renderGraph.compute("pass")
+                    .addStorageBufferRead(buffers[(i + 1) % buffers.size()])
+                    .addStorageBufferRead(buffers[i % buffers.size()])
+                    .addStorageBufferWrite(buffers[i % buffers.size()]);
+            buffers[i % buffers.size()] = *pass.output<canta::BufferIndex>();
+        }
+        renderGraph.setRoot(buffers[(passCount - 1) % buffers.size()]);
+    };
+
+    BENCHMARK_ADVANCED("compile 1k passes")(Catch::Benchmark::Chronometer meter) {
+        buildGraph(1000);
+        meter.measure([&] {
+            renderGraph.invalidate();
+            return renderGraph.compile();
+        });
+    };
+
+    BENCHMARK_ADVANCED("compile 10k passes")(Catch::Benchmark::Chronometer meter) {
+        buildGraph(10000);
+        meter.measure([&] {
+            renderGraph.invalidate();
+            return renderGraph.compile();
+        });
+    };
+}